@@ -0,0 +1,96 @@
+//C interface to the scheduling solver, so other programs can solve rosters in process instead of running it on files
+//compile ApplewoodSchedulingAlgorithm.cpp with APPLEWOOD_LIBRARY defined to leave out main() and link it in as a library
+//rosters are given in the same csv formats as "scheduling.csv" and "locked.csv", so anything the program reads can be solved here
+#ifndef APPLEWOOD_SCHEDULING_H
+#define APPLEWOOD_SCHEDULING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define APPLEWOOD_API_VERSION 1 //increased whenever a function or struct below changes in a way existing callers would notice
+
+#define APPLEWOOD_OK 0 //the call succeeded
+#define APPLEWOOD_ERROR 1 //the call failed, applewood_last_error describes why
+
+//a roster and the last schedule solved from it, a problem must only be used by one thread at a time
+typedef struct ApplewoodProblem ApplewoodProblem;
+
+//options for a solve, a zero initialized struct gives the defaults
+typedef struct ApplewoodSolveOptions
+{
+	uint32_t seed; //seed for the random number generator, used when hasSeed is not 0
+	int hasSeed; //a seed is generated from the OS's random device when this is 0
+	double timeLimit; //seconds a solve can run before it returns the schedule filled so far, no limit if 0 or less
+	uint64_t iterationLimit; //number of spots a solve can try to fill before it returns the schedule filled so far, no limit if 0
+	int neighbourhoodIterations; //iterations of large neighbourhood search run on the filled schedule
+	int matching; //fills all the slots at each time at once with a min cost matching when not 0
+	int noSymmetry; //searches interchangeable activities and staff separately when not 0
+} ApplewoodSolveOptions;
+
+//one slot of a solved schedule
+typedef struct ApplewoodAssignment
+{
+	int day; //day of the slot, from 1
+	int period; //period of the slot, from 1
+	char level; //group level of the slot, 'A' onwards
+	int participants; //number of participants in the slot
+	const char* activity; //name of the activity filling the slot, NULL if it is unfilled
+	const char* staff; //name of the staff member leading the slot, NULL if it is unfilled
+} ApplewoodAssignment;
+
+//the quality of a solved schedule and the run which produced it
+typedef struct ApplewoodSummary
+{
+	int unfilledSlots; //number of slots which could not be filled
+	int preferenceCost; //0 for each slot led by a staff member who prefers its activity, 1 if they are neutral and 2 if they prefer not to
+	int budgetExhausted; //not 0 if the solve stopped at its time or iteration limit
+	uint32_t seed; //the seed of the run
+	uint64_t fingerprint; //the fingerprint of the run
+} ApplewoodSummary;
+
+//gets the API version the library was built with
+int applewood_api_version(void);
+
+//creates a problem from the contents of a scheduling csv and an optional locked assignments csv, which are copied
+//either buffer may be empty, with entities then added one row at a time, NULL is returned only when memory runs out
+ApplewoodProblem* applewood_create(const char* scheduling, size_t schedulingSize, const char* locked, size_t lockedSize);
+
+//add one row, in the format of its section of the csv, to the activities, staff, participants or locked assignments of a problem
+//rows are checked when the problem is next solved
+int applewood_add_activity(ApplewoodProblem* problem, const char* row);
+int applewood_add_staff(ApplewoodProblem* problem, const char* row);
+int applewood_add_participant(ApplewoodProblem* problem, const char* row);
+int applewood_add_locked(ApplewoodProblem* problem, const char* row);
+
+//solves a problem with the given options, or the defaults if options is NULL, replacing the last schedule solved
+//the roster is only read in again after rows have been added, so repeated solves skip reading it and reuse its memory
+int applewood_solve(ApplewoodProblem* problem, const ApplewoodSolveOptions* options);
+
+//gets the number of slots in the last schedule solved, 0 if none has been
+size_t applewood_assignment_count(const ApplewoodProblem* problem);
+
+//gets the slot at a given index of the last schedule solved, its names stay valid until the next solve or free
+int applewood_get_assignment(const ApplewoodProblem* problem, size_t index, ApplewoodAssignment* assignment);
+
+//gets the name of one of the staff helping to lead the slot at a given index, when its participants need more than one staff member
+//NULL once assistant passes the last one, the name stays valid until the next solve or free
+const char* applewood_get_assistant(const ApplewoodProblem* problem, size_t index, size_t assistant);
+
+//gets the summary of the last schedule solved
+int applewood_get_summary(const ApplewoodProblem* problem, ApplewoodSummary* summary);
+
+//gets why the last call on a problem failed, empty if it did not
+const char* applewood_last_error(const ApplewoodProblem* problem);
+
+//frees a problem and everything it holds
+void applewood_free(ApplewoodProblem* problem);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -7,18 +7,334 @@
 #include <string>
 #include <optional>
 #include <random>
+#include <cstdint>
+#include <sstream>
+#include <iomanip>
+#include <bitset>
+#include <limits>
+#include <map>
+#include <bit>
+#include <chrono>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+#include <span>
+#include <exception>
+#include <tuple>
+#include <charconv>
+#include <list>
+
+#include "ApplewoodScheduling.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <poll.h>
+#endif
 
 constexpr int daysInCycle{ 5 }; //number of days in generated schedule
 constexpr int periodsInDay{ 10 }; //number of periods (schedule slots) in each day
 
-std::random_device rd{};
-std::seed_seq ss{ rd(), rd(), rd(), rd(), rd(), rd(), rd(), rd() }; //generates a seed sequence using the OS's random device
-std::mt19937 mt{ ss }; //seeds merene twister using the generated seed sequence
+#ifndef APPLEWOOD_BUILD_ID
+#define APPLEWOOD_BUILD_ID "unversioned" //the build system passes in the commit or version being built
+#endif
+constexpr std::string_view buildID{ APPLEWOOD_BUILD_ID }; //identifies the build so runs from different builds get different fingerprints
 
+//a fixed width set of schedule slots stored as a 256 bit mask indexed by slot ID
+//intersections and searches use AVX2 when it is enabled at compile time, otherwise one 64 bit word at a time
+struct SlotMask
+{
+	static constexpr int size{ 256 }; //the number of slots a mask can hold
+
+	alignas(32) std::array<std::uint64_t, 4> m_words{};
+
+	//gets whether two masks hold the same slots
+	friend bool operator==(const SlotMask& mask1, const SlotMask& mask2) = default;
+
+	//adds the slot with the given ID
+	void set(const int slotID)
+	{
+		m_words[slotID >> 6] |= 1ull << (slotID & 63);
+	}
+
+	//removes the slot with the given ID
+	void reset(const int slotID)
+	{
+		m_words[slotID >> 6] &= ~(1ull << (slotID & 63));
+	}
+
+	//gets whether the slot with the given ID is in this mask
+	bool test(const int slotID) const
+	{
+		return (m_words[slotID >> 6] >> (slotID & 63)) & 1;
+	}
+
+	//removes every slot
+	void clear()
+	{
+		m_words.fill(0);
+	}
+
+	//gets the number of slots in this mask
+	int count() const
+	{
+		return std::popcount(m_words[0]) + std::popcount(m_words[1]) + std::popcount(m_words[2]) + std::popcount(m_words[3]);
+	}
+
+	//gets the slots in both this and a given mask
+	SlotMask operator&(const SlotMask& other) const
+	{
+		SlotMask common{};
+#if defined(__AVX2__)
+		__m256i words{ _mm256_load_si256(reinterpret_cast<const __m256i*>(m_words.data())) };
+		__m256i otherWords{ _mm256_load_si256(reinterpret_cast<const __m256i*>(other.m_words.data())) };
+		_mm256_store_si256(reinterpret_cast<__m256i*>(common.m_words.data()), _mm256_and_si256(words, otherWords));
+#else
+		for (std::size_t word{ 0 }; word < m_words.size(); ++word)
+			common.m_words[word] = m_words[word] & other.m_words[word];
+#endif
+		return common;
+	}
+
+	//gets whether this and a given mask have any slot in common
+	bool intersects(const SlotMask& other) const
+	{
+#if defined(__AVX2__)
+		__m256i words{ _mm256_load_si256(reinterpret_cast<const __m256i*>(m_words.data())) };
+		__m256i otherWords{ _mm256_load_si256(reinterpret_cast<const __m256i*>(other.m_words.data())) };
+		return !_mm256_testz_si256(words, otherWords);
+#else
+		return ((m_words[0] & other.m_words[0]) | (m_words[1] & other.m_words[1]) | (m_words[2] & other.m_words[2]) | (m_words[3] & other.m_words[3])) != 0;
+#endif
+	}
+
+	//gets the number of slots in both this and a given mask
+	int countCommon(const SlotMask& other) const
+	{
+		return (*this & other).count();
+	}
+
+	//gets the lowest ID of a slot in both this and a given mask, -1 if there is none
+	int findFirstCommon(const SlotMask& other) const
+	{
+		SlotMask common{ *this & other };
+#if defined(__AVX2__)
+		__m256i words{ _mm256_load_si256(reinterpret_cast<const __m256i*>(common.m_words.data())) };
+		int zeroWords{ _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(words, _mm256_setzero_si256()))) };
+		if (zeroWords == 0xF)
+			return -1;
+		int word{ std::countr_zero(static_cast<unsigned int>(~zeroWords & 0xF)) };
+		return word * 64 + std::countr_zero(common.m_words[word]);
+#else
+		for (std::size_t word{ 0 }; word < common.m_words.size(); ++word)
+		{
+			if (common.m_words[word] != 0)
+				return static_cast<int>(word) * 64 + std::countr_zero(common.m_words[word]);
+		}
+		return -1;
+#endif
+	}
+
+	//calls a given function with the ID of every slot in this mask, lowest first
+	template <typename Function>
+	void forEach(Function function) const
+	{
+		for (std::size_t word{ 0 }; word < m_words.size(); ++word)
+		{
+			for (std::uint64_t bits{ m_words[word] }; bits != 0; bits &= bits - 1)
+				function(static_cast<int>(word) * 64 + std::countr_zero(bits));
+		}
+	}
+};
+
+class SpotWrapper;
 class Activity;
 class Staff; //staff class prototype so it can be referred to in Activity
 class ActivityCategory; //Activity Category class prototype so it can be referred to in Activity
 class ScheduleSlot; //Schedule Slot class prototype so it can be referred to in Activity
+class SpotTable; //Spot Table class prototype so spots can look up the spots they refer to
+
+//the ID of a spot of a given type, stored in 16 bits so the lists of IDs each spot keeps stay small
+//spots refer to each other by ID rather than by pointer so copies of the spots are valid without reseating anything
+template <typename T>
+struct SpotId
+{
+	static constexpr int none{ 0xFFFF }; //the value of an ID which refers to no spot, so every ID is smaller than it
+
+	std::uint16_t value{ none };
+
+	constexpr SpotId() = default;
+
+	//creates the ID of the spot with a given ID
+	constexpr explicit SpotId(const int id)
+		: value{ static_cast<std::uint16_t>(id) }
+	{
+	}
+
+	//converts the ID of a spot to the ID of a more general type of spot, e.g. a slot's ID to a spot's ID
+	template <typename U>
+		requires std::is_base_of_v<T, U>
+	constexpr SpotId(const SpotId<U> id)
+		: value{ id.value }
+	{
+	}
+
+	//gets the ID as an int, for use as an index
+	constexpr int get() const
+	{
+		return value;
+	}
+
+	friend constexpr bool operator==(const SpotId id1, const SpotId id2) = default;
+};
+
+using SlotId = SpotId<ScheduleSlot>;
+using ActivityId = SpotId<Activity>;
+using StaffId = SpotId<Staff>;
+
+//gets the typed ID of a given spot
+template <typename T>
+constexpr SpotId<T> getSpotId(const T& spot)
+{
+	return SpotId<T>{ spot.getID() };
+}
+
+//a list of spot IDs which can remove any spot in constant time, used for the option lists each spot keeps
+//live spots are kept at the front in no particular order, removing a spot swaps it with the last live spot
+//removed spots are kept behind the live ones, so the most recently removed spot can be restored by moving the end back
+template <typename T>
+class SpotList
+{
+	std::vector<SpotId<T>> m_spots{}; //the live spots, followed by the removed spots from most to least recently removed
+	std::vector<std::uint16_t> m_positions{}; //the position of each spot in m_spots indexed by ID, none for spots never added
+	std::size_t m_size{ 0 }; //number of live spots
+
+	static constexpr std::uint16_t none{ 0xFFFF }; //the position of a spot which has never been added
+
+	//records the position of a given spot, growing the position list to fit its ID
+	constexpr void setPosition(const SpotId<T> spot, const std::size_t position)
+	{
+		std::size_t id{ static_cast<std::size_t>(spot.get()) };
+		if (id >= m_positions.size())
+			m_positions.resize(id + 1, none);
+		m_positions[id] = static_cast<std::uint16_t>(position);
+	}
+
+public:
+
+	SpotList() = default;
+
+	//initializes the list with the given spots
+	constexpr SpotList(std::vector<SpotId<T>> spots)
+	{
+		*this = std::move(spots);
+	}
+
+	//replaces the contents of this list with the given spots
+	constexpr SpotList& operator=(std::vector<SpotId<T>> spots)
+	{
+		m_spots = std::move(spots);
+		m_size = m_spots.size();
+		m_positions.clear();
+		for (std::size_t index{ 0 }; index < m_spots.size(); ++index)
+			setPosition(m_spots[index], index);
+		return *this;
+	}
+
+	//adds a spot to the end of the live spots, forgetting any removed spots since they can no longer be restored in order
+	constexpr void push_back(const SpotId<T> spot)
+	{
+		m_spots.resize(m_size);
+		m_spots.push_back(spot);
+		setPosition(spot, m_size);
+		++m_size;
+	}
+
+	//returns whether a given spot is live in this list
+	constexpr bool contains(const SpotId<T> spot) const
+	{
+		std::size_t id{ static_cast<std::size_t>(spot.get()) };
+		//positions of removed spots are not cleared so they may point at another spot
+		return id < m_positions.size() && m_positions[id] < m_size && m_spots[m_positions[id]] == spot;
+	}
+
+	//removes a given spot by swapping it with the last live spot, returns whether the spot was in the list
+	constexpr bool remove(const SpotId<T> spot)
+	{
+		if (!contains(spot))
+			return false;
+
+		std::size_t position{ m_positions[spot.get()] };
+		--m_size;
+		std::swap(m_spots[position], m_spots[m_size]);
+		setPosition(m_spots[position], position);
+		setPosition(m_spots[m_size], m_size);
+		return true;
+	}
+
+	//restores the most recently removed spot, spots must be restored in the reverse order they were removed
+	constexpr void restore()
+	{
+		if (m_size == m_spots.size())
+			throw "No removed spot to restore";
+		++m_size;
+	}
+
+	//removes all spots
+	constexpr void clear()
+	{
+		m_spots.clear();
+		m_size = 0;
+	}
+
+	//gets the number of live spots
+	constexpr std::size_t size() const
+	{
+		return m_size;
+	}
+
+	//returns whether there are no live spots
+	constexpr bool empty() const
+	{
+		return m_size == 0;
+	}
+
+	//gets the removed spots, from most to least recently removed
+	constexpr std::span<const SpotId<T>> getRemoved() const
+	{
+		return { m_spots.begin() + m_size, m_spots.end() };
+	}
+
+	//gets the live spot at a given position
+	constexpr SpotId<T> operator[](const std::size_t index) const
+	{
+		return m_spots[index];
+	}
+
+	//gets the start of the live spots
+	constexpr typename std::vector<SpotId<T>>::const_iterator begin() const
+	{
+		return m_spots.begin();
+	}
+
+	//gets the end of the live spots
+	constexpr typename std::vector<SpotId<T>>::const_iterator end() const
+	{
+		return m_spots.begin() + m_size;
+	}
+};
 
 //Wrapper which provides generic implementation for Activity, ScheduleSlot and Staff objects
 class SpotWrapper
@@ -38,106 +354,64 @@ public:
 	virtual constexpr std::pair<int, int> getNumberToDiscard() const = 0; //gets number of options to be discarded before filling the spot
 	virtual constexpr Type getType() = 0; //object type
 	virtual void removeFromThis(SpotWrapper* spot) = 0; //remove a spot (not a ScheduleSlot) from this object
-	std::vector<SpotWrapper*> m_availableSpots{}; //stores the available spots to fill this spot
+	SpotList<SpotWrapper> m_availableSpots{}; //stores the IDs of the available spots to fill this spot
 	int m_index{}; //stores the index in Fill Spot's spotsToBeFilled
 	int m_timesPerCycle{}; //number of times this spot should occur in the generated schedule
 	int m_timesLeftPerCycle{}; //how many more of this spot should occur
-	int m_id{}; //the unique id of the spot
-	static int id; //holds id of next spot
+	int m_id{}; //the unique id of the spot, given by the roster reader so that each roster numbers its own spots
 	bool m_completed{ false }; //stores whether or not this object has been filled
 
-	std::vector <Activity*> m_activities{}; //a list of the activities filled by this spot
-	std::vector <ScheduleSlot*> m_slots{}; //a list of the slots filled by this spot
-	std::vector <Staff*> m_staff{};  //a list of the staff filled by this spot
+	std::vector <ActivityId> m_activities{}; //a list of the activities filled by this spot
+	std::vector <SlotId> m_slots{}; //a list of the slots filled by this spot
+	std::vector <StaffId> m_staff{};  //a list of the staff filled by this spot
+
 
+	SpotList<ScheduleSlot> m_timesAvailable{}; //holds the IDs of the schedule slots where this spot can occur
+	SlotMask m_slotMask{}; //holds the IDs of the schedule slots in m_timesAvailable so slot lookups are a single bit test
 
-	std::vector <ScheduleSlot*> m_timesAvailable{}; //holds the indices of the schedule slots where this spot can occur
 
+	std::uint64_t m_sortKey{}; //packs how soon this spot should be filled into one integer, kept up to date by updateSortKey
 
 	//the spots with the least variation of options of places to go should be filled first, ties should be solved by least available staff to lead, then most spots left to fill
-	//spots are valued based upon on soon they should be filled (soonest = lowest)
-	friend bool operator> (SpotWrapper& spot1, SpotWrapper& spot2)
+	//spots are valued based upon on soon they should be filled (soonest = lowest), which the packed sort key holds so comparing is one integer compare
+	friend bool operator> (const SpotWrapper& spot1, const SpotWrapper& spot2)
 	{
-
-		//if a spot is completed, move to the front of the list so it can be removed
-		if (spot1.getCompleted())
-			return false;
-		if (spot2.getCompleted())
-			return true;
-
-		//gets the min and max of the pair of number to discard for each spot
-		int spot1Min{ std::get<0>(spot1.getNumberToDiscard()) };
-		int spot1Max{ std::get<1>(spot1.getNumberToDiscard()) };
-		if (spot1Min > spot1Max)
-			std::swap(spot1Min, spot1Max);
-		int spot2Min{ std::get<0>(spot2.getNumberToDiscard()) };
-		int spot2Max{ std::get<1>(spot2.getNumberToDiscard()) };
-		if (spot2Min > spot2Max)
-			std::swap(spot2Min, spot2Max);
-
-
-
-		//sorts by largest minimum options to discard
-		if (spot1Min > spot2Min)
-			return true;
-		else if (spot1Min < spot2Min)
-			return false;
-
-		//breaks ties by largest largest options to discard
-		if (spot1Max > spot2Max)
-			return true;
-		else if (spot1Max < spot2Max)
-			return false;
-
-		//break remaining ties by least spots left to fill
-		else if (spot1.m_timesLeftPerCycle < spot2.m_timesLeftPerCycle)
-			return true;
-		else
-			return false;
+		return spot1.m_sortKey > spot2.m_sortKey;
 	}
 
-	friend bool operator< (SpotWrapper& spot1, SpotWrapper& spot2)
+	friend bool operator< (const SpotWrapper& spot1, const SpotWrapper& spot2)
 	{
+		return spot1.m_sortKey < spot2.m_sortKey;
+	}
 
-		//if a spot is completed, move to the front of the list so it can be removed
-		if (spot1.getCompleted())
-			return true;
-		if (spot2.getCompleted())
-			return false;
-
-		//gets the min and max of the pair of number to discard for each spot
-		int spot1Min{ std::get<0>(spot1.getNumberToDiscard()) };
-		int spot1Max{ std::get<1>(spot1.getNumberToDiscard()) };
-		if (spot1Min > spot1Max)
-			std::swap(spot1Min, spot1Max);
-		int spot2Min{ std::get<0>(spot2.getNumberToDiscard()) };
-		int spot2Max{ std::get<1>(spot2.getNumberToDiscard()) };
-		if (spot2Min > spot2Max)
-			std::swap(spot2Min, spot2Max);
-
-
-
-		//sorts by largest minimum options to discard
-		if (spot1Min < spot2Min)
-			return true;
-		else if (spot1Min > spot2Min)
-			return false;
-
-		//breaks ties by largest largest options to discard
-		if (spot1Max < spot2Max)
-			return true;
-		else if (spot1Max > spot2Max)
-			return false;
+	//recalculates the packed sort key, must be called whenever the number to discard, times left or completed status changes
+	//from most to least significant bits: not completed (1), smaller number to discard (15), larger number to discard (15), most spots left to fill (16) and id (17)
+	//completed spots sort to the front so they can be removed
+	void updateSortKey()
+	{
+		if (m_completed)
+		{
+			m_sortKey = static_cast<std::uint64_t>(m_id);
+			return;
+		}
 
-		//break remaining ties by least spots left to fill
-		else if (spot1.m_timesLeftPerCycle > spot2.m_timesLeftPerCycle)
-			return true;
-		else
-			return false;
+		//gets the min and max of the pair of number to discard, biased by half their field so negative numbers keep their order
+		//a spot short of options has a negative number to discard, and the shorter it is the sooner it should be filled
+		constexpr int discardBias{ 0x4000 };
+		std::pair<int, int> numberToDiscard{ getNumberToDiscard() };
+		int min{ std::clamp(std::min(numberToDiscard.first, numberToDiscard.second) + discardBias, 0, 0x7FFF) };
+		int max{ std::clamp(std::max(numberToDiscard.first, numberToDiscard.second) + discardBias, 0, 0x7FFF) };
+		int timesLeft{ std::clamp(m_timesLeftPerCycle, 0, 0xFFFF) };
+
+		m_sortKey = (1ull << 63)
+			| (static_cast<std::uint64_t>(min) << 48)
+			| (static_cast<std::uint64_t>(max) << 33)
+			| (static_cast<std::uint64_t>(0xFFFF - timesLeft) << 17)
+			| static_cast<std::uint64_t>(m_id & 0x1FFFF);
 	}
 
 	//gets spots that can fill this spot
-	std::vector<SpotWrapper*>& getAvailableSpots()
+	SpotList<SpotWrapper>& getAvailableSpots()
 	{
 		return m_availableSpots;
 	}
@@ -161,31 +435,25 @@ public:
 	}
 
 	//gets timesAvailable array
-	std::vector <ScheduleSlot*>& getTimesAvailable()
+	SpotList<ScheduleSlot>& getTimesAvailable()
 	{
 		return m_timesAvailable;
 	}
 
-	//removes a given spot from a given array in this spot
+	//removes a given spot from a given array in this spot in constant time, returns whether the spot was in the array
 	template <typename T>
-	bool removeSpot(SpotWrapper* spot, std::vector<T*>& array)
+	bool removeSpot(SpotWrapper* spot, SpotList<T>& array)
 	{
-		for (std::size_t index{ 0 }; index < array.size(); ++index)
-		{
-			if (array[index] == spot)
-			{
-				array.erase(array.begin(), array.end() + index);
-				return true;
-			}
-		}
-		return false;
+		return array.remove(SpotId<T>{ spot->getID() });
 	}
 
-	//adds two spots to this spot
-	void add(SpotWrapper* spot1, SpotWrapper* spot2)
+	//adds the other two spots of a triple to this spot, looking up the spots this spot refers to in a given table
+	//a triple fills this spot once, so it only counts as one of this spot's times
+	void add(SpotWrapper* spot1, SpotWrapper* spot2, SpotTable& spots)
 	{
-		add(spot1);
-		add(spot2);
+		record(spot1, spots);
+		record(spot2, spots);
+		countFilled(spots);
 	}
 
 	//gets the completed status of this spot
@@ -210,6 +478,7 @@ public:
 	void setTimesLeftPerCycle(const int timesLeftPerCycle)
 	{
 		m_timesLeftPerCycle = timesLeftPerCycle;
+		updateSortKey();
 	}
 
 	//increases the number of times this spot will occur by 1
@@ -222,10 +491,14 @@ public:
 	void incrementTimesLeftPerCycle()
 	{
 		++m_timesLeftPerCycle;
+		updateSortKey();
 	}
 
 	void remove(SpotWrapper* spot);
-	void add(SpotWrapper* spot);
+	void add(SpotWrapper* spot, SpotTable& spots);
+	void record(SpotWrapper* spot, SpotTable& spots);
+	void countFilled(SpotTable& spots);
+	void rebuildSlotMask();
 
 };
 
@@ -249,6 +522,22 @@ enum class Level
 	maxLevel, //used for finding number of levels
 };
 
+static_assert(static_cast<int>(Level::maxLevel) * daysInCycle * periodsInDay <= SlotMask::size, "every schedule slot ID must fit in a slot mask");
+
+//gets the ID of the slot of a given level at a given time, slots are numbered level by level so the slots at the same time are one level's worth of IDs apart
+constexpr int getSlotID(const int level, const int time)
+{
+	return level * daysInCycle * periodsInDay + time;
+}
+
+constexpr int numberOfSlotIDs{ static_cast<int>(Level::maxLevel) * daysInCycle * periodsInDay }; //slots take the first IDs of a roster, activities and staff follow them
+
+//gets the time of the slot with a given ID
+constexpr int getSlotTime(const int slotID)
+{
+	return slotID % (daysInCycle * periodsInDay);
+}
+
 //converts char to Level
 Level getLevel(const char c)
 {
@@ -260,7 +549,8 @@ Level getLevel(const char c)
 		return Level::B;
 	case('C'):
 		return Level::C;
-		throw "Invlaid char to level conversion";
+	default:
+		throw "Invalid group level, levels are A, B or C\n";
 	}
 }
 
@@ -269,12 +559,11 @@ class ScheduleSlot : public SpotWrapper
 {
 	int m_numberOfParticipants{ 0 }; //the number of participants participating in this scheduleSlot
 
-	const int m_time{ 0 }; //the time which this schedule slot takes place at
-	std::vector <Activity*> m_possibleActivities{}; //A list of possible activities to occur in this slot
-	std::vector <Staff*> m_possibleStaff{}; //A list of possible staff to occur in this slot
+	int m_time{ 0 }; //the time which this schedule slot takes place at
+	SpotList<Activity> m_possibleActivities{}; //A list of possible activities to occur in this slot
+	SpotList<Staff> m_possibleStaff{}; //A list of possible staff to occur in this slot
 	Room* m_room{ nullptr }; //a pointer to the room this slot occurs in
 	Level m_level{}; //the group level of this scheduleSlot
-	std::vector<ScheduleSlot*> m_slotsAtSameTime{}; //the slots that occur at the same time as this slot
 
 public:
 
@@ -282,19 +571,19 @@ public:
 
 
 
-	//intializes schedule slot using the time the slot occurs at and its level
-	ScheduleSlot(const int time, const Level level)
+	//intializes schedule slot using the time the slot occurs at, its level and its unique id
+	ScheduleSlot(const int time, const Level level, const int id)
 		:m_time{ time },
 		m_level{ level }
 	{
 		m_timesPerCycle = 1;
 		m_timesLeftPerCycle = 1;
-		m_id = id; //assings object's unique id as next id to add
-		++id; //iterates Spotwrapper ID to ensure each object has a unique ID
+		m_id = id;
+		updateSortKey();
 	}
 
 	//adds a staff to the availableToLead array
-	constexpr void addAvailableToLead(Staff* staff)
+	constexpr void addAvailableToLead(const StaffId staff)
 	{
 		m_possibleStaff.push_back(staff);
 	}
@@ -319,13 +608,13 @@ public:
 	}
 
 	//adds a given staff member to the possible staff to fill this slot
-	void addPossibleStaff(Staff* staff)
+	void addPossibleStaff(const StaffId staff)
 	{
 		m_possibleStaff.push_back(staff);
 	}
 
 	//adds a given activity to the possible activities to fill this slot
-	void addPossibleActivities(Activity* activity)
+	void addPossibleActivities(const ActivityId activity)
 	{
 		m_possibleActivities.push_back(activity);
 	}
@@ -339,23 +628,18 @@ public:
 			removeSpot(spot, m_possibleStaff);
 	}
 
-	//returns the schedule slots occuring at the same time as this slot
-	std::vector<ScheduleSlot*>& getSlotsAtSameTime()
-	{
-		return m_slotsAtSameTime;
-	}
-
-	void addSlotAtSameTime(ScheduleSlot* slot)
-	{
-		m_slotsAtSameTime.push_back(slot);
-	}
-
 	//adds a participant to this schedule slot
 	void addParticipant()
 	{
 		++m_numberOfParticipants;
 	}
 
+	//adds a given number of participants to this schedule slot
+	void addParticipants(const int count)
+	{
+		m_numberOfParticipants += count;
+	}
+
 	//gets the number if participants, participating in this schedule slot
 	constexpr int getNumberOfParticipants() const
 	{
@@ -363,47 +647,57 @@ public:
 	}
 
 	//gets possibleActivities array
-	std::vector <Activity*>& getActivitiesAvailable()
+	SpotList<Activity>& getActivitiesAvailable()
 	{
 		return m_possibleActivities;
 	}
 
 	//gets possibleActivities array
-	std::vector <Staff*>& getStaffAvailable()
+	SpotList<Staff>& getStaffAvailable()
 	{
 		return m_possibleStaff;
 	}
 
-	constexpr int getNumberOfParticipants() const
+	//gets the room this slot occurs in, nullptr if it has not been given one
+	const Room* getRoom() const
 	{
-		return m_numberOfParticipants;
+		return m_room;
 	}
 
 
 };
 
+//how many staff an activity needs to run safely, read in from the optional columns after its times per cycle
+struct StaffRatio
+{
+	int campersPerStaff{ 0 }; //most participants one staff member can supervise, no ratio if 0
+	int minimumStaff{ 1 }; //fewest staff who can run the activity however few participants it has (e.g. 2 for waterfront activities)
+};
+
 //Represents each activity
 class Activity :public SpotWrapper
 {
 	ActivityCategory* m_activityCategory{ nullptr }; //holds a pointer to the activity category which this activity belongs to
 
 	std::string m_activityName{}; //the display name of the activity
+	StaffRatio m_ratio{}; //the staff needed to run this activity for its participants
 
-	std::vector <Staff*> m_preferredStaff{}; //a list of the staff who prefer to lead this spot
-	std::vector <Staff*> m_neutralStaff{}; //a list of the staff who are neutral towards leading this spot
-	std::vector <Staff*> m_unpreferredStaff{}; //a list of the staff who prefer not to lead this spot
+	SpotList<Staff> m_preferredStaff{}; //a list of the staff who prefer to lead this spot
+	SpotList<Staff> m_neutralStaff{}; //a list of the staff who are neutral towards leading this spot
+	SpotList<Staff> m_unpreferredStaff{}; //a list of the staff who prefer not to lead this spot
 
 	std::vector<Room*> potentialRooms{}; //a list of pointers to all rooms this activity can occur in
 
 	//adds list of possible activities to this slot and adds this slot to the timeavailable of each of those activities
-	void setTimesAvailable(std::vector<ScheduleSlot*>& possibleSlots)
+	void setTimesAvailable(const std::vector<ScheduleSlot*>& possibleSlots)
 	{
-		m_timesAvailable = std::move(possibleSlots);
-		for (auto slot : m_timesAvailable)
+		for (ScheduleSlot* slot : possibleSlots)
 		{
-			m_availableSpots.push_back(slot);
-			slot->m_availableSpots.push_back(this);
-			slot->addPossibleActivities(this);
+			m_timesAvailable.push_back(getSpotId(*slot));
+			m_slotMask.set(slot->getID());
+			m_availableSpots.push_back(getSpotId(*slot));
+			slot->m_availableSpots.push_back(getSpotId(*this));
+			slot->addPossibleActivities(getSpotId(*this));
 		}
 	}
 
@@ -411,15 +705,16 @@ public:
 
 	Activity() = default; //a default constructor with no arguments
 
-	//creates Activity using its display name, how many times and when it should happen.
-	Activity(const std::string_view activityName, const int timesPerCycle, std::vector<ScheduleSlot*>& possibleTimes)
-		: m_activityName{ activityName }
+	//creates Activity using its display name, how many times and when it should happen, its unique id and the staff it needs
+	Activity(const std::string_view activityName, const int timesPerCycle, std::vector<ScheduleSlot*>& possibleTimes, const int id, const StaffRatio& ratio = {})
+		: m_activityName{ activityName },
+		m_ratio{ ratio }
 	{
+		m_id = id; //set first since the slots are given this activity's ID
 		setTimesAvailable(possibleTimes);
 		m_timesPerCycle = timesPerCycle;
 		m_timesLeftPerCycle = timesPerCycle;
-		m_id = id; //assings object's unique id as next id to add
-		++id; //iterates Spotwrapper ID to ensure each object has a unique ID
+		updateSortKey();
 	}
 
 
@@ -436,6 +731,19 @@ public:
 		m_activityCategory = activityCategory;
 	}
 
+	//gets the staff needed to run this activity
+	constexpr const StaffRatio& getStaffRatio() const
+	{
+		return m_ratio;
+	}
+
+	//gets the number of staff, the lead included, needed to run this activity for a given number of participants
+	constexpr int getStaffNeeded(const int participants) const
+	{
+		int needed{ m_ratio.campersPerStaff > 0 ? (participants + m_ratio.campersPerStaff - 1) / m_ratio.campersPerStaff : 1 };
+		return std::max(needed, m_ratio.minimumStaff);
+	}
+
 	//Discarded slots are spots - number of spots to fill, discarded staff can be as high as staff since they can lead the activity many times
 	constexpr std::pair<int, int> getNumberToDiscard() const
 	{
@@ -450,19 +758,19 @@ public:
 	}
 
 	//adds a preferred staff member to this activity
-	void addPreferredStaff(Staff* staff)
+	void addPreferredStaff(const StaffId staff)
 	{
 		m_preferredStaff.push_back(staff);
 	}
 
 	//adds a neutral staff member to this activity
-	void addNeutralStaff(Staff* staff)
+	void addNeutralStaff(const StaffId staff)
 	{
 		m_neutralStaff.push_back(staff);
 	}
 
 	//adds an unpreferred staff member to this activity
-	void addUnpreferredStaff(Staff* staff)
+	void addUnpreferredStaff(const StaffId staff)
 	{
 		m_unpreferredStaff.push_back(staff);
 	}
@@ -479,19 +787,19 @@ public:
 	}
 
 	//gets m_preferredStaff array
-	std::vector <Staff*>& getPreferredStaff()
+	SpotList<Staff>& getPreferredStaff()
 	{
 		return m_preferredStaff;
 	}
 
 	//gets m_neutralStaff array
-	std::vector <Staff*>& getNeutralStaff()
+	SpotList<Staff>& getNeutralStaff()
 	{
 		return m_neutralStaff;
 	}
 
 	//gets m_unpreferredStaff array
-	std::vector <Staff*>& getUnpreferredStaff()
+	SpotList<Staff>& getUnpreferredStaff()
 	{
 		return m_unpreferredStaff;
 	}
@@ -513,8 +821,8 @@ public:
 
 	//creates ActivityCategory using its name and an array of its activities
 	ActivityCategory(std::string_view activityCategoryName, std::vector<Activity>& activities)
-		:m_activities{ std::move(activities) }, //activities are moved to save computing costs of copying the list
-		m_activityCategoryName{ activityCategoryName },
+		:m_activityCategoryName{ activityCategoryName },
+		m_activities{ std::move(activities) }, //activities are moved to save computing costs of copying the list
 		m_activityCounter{ 0 }
 	{
 
@@ -573,78 +881,142 @@ public:
 };
 
 
+//limits on how much a staff member can lead, read in from the optional columns after their breaks
+struct StaffLimits
+{
+	int minimumLoad{ 0 }; //fewest slots the staff member should lead in the cycle
+	int maximumLoad{ 10 }; //most slots the staff member can lead in the cycle
+	int dailyCap{ periodsInDay }; //most slots the staff member can lead in one day
+	int maxConsecutive{ periodsInDay }; //most slots in a row the staff member can lead without a free period
+};
+
 //stores staff members
 class Staff : public SpotWrapper
 {
 	std::string m_name{}; //staff name
+	StaffLimits m_limits{}; //limits on this staff member's workload
+	int m_load{ 0 }; //number of slots this staff member leads
+	std::array<int, daysInCycle> m_periodsOnDay{}; //number of slots this staff member leads on each day
+	std::array<std::uint32_t, daysInCycle> m_busyPeriods{}; //a bit for each period of each day this staff member leads at, runs of set bits are consecutive periods
+
+	//removes the slots at the given times from this staff member and this staff member from those slots, except for a slot being filled
+	template <typename Function>
+	void removeSlotsWhere(Function atTime, SpotTable& spots, const ScheduleSlot* filledSlot);
+
+	//gets the number of periods led in a row which end just before a given period of a given day
+	int getRunBelow(const int day, const int period) const
+	{
+		return period == 0 ? 0 : std::countl_one(m_busyPeriods[day] << (32 - period));
+	}
+
+	//gets the number of periods led in a row which start just after a given period of a given day
+	int getRunAbove(const int day, const int period) const
+	{
+		return period + 1 >= periodsInDay ? 0 : std::countr_one(m_busyPeriods[day] >> (period + 1));
+	}
 
-	std::vector<Activity*> m_preferredActivities{}; //holds the list of activities that this staff would prefer to lead
-	std::vector<Activity*> m_neutralActivities{}; //holds the list of activities that this staff feels neutral towards leading
-	std::vector<Activity*> m_unpreferredActivities{}; //holds the lsit of activities that this staff would not prefer to lead
+	SpotList<Activity> m_preferredActivities{}; //holds the list of activities that this staff would prefer to lead
+	SpotList<Activity> m_neutralActivities{}; //holds the list of activities that this staff feels neutral towards leading
+	SpotList<Activity> m_unpreferredActivities{}; //holds the lsit of activities that this staff would not prefer to lead
 
 	//adds list of preferred activities to this staff member and adds this staff to the preferred staff of each of those activities
-	void setPreferredActivities(std::vector<Activity*> preferredActivities)
+	void setPreferredActivities(const std::vector<Activity*>& preferredActivities)
 	{
-		m_preferredActivities = std::move(preferredActivities);
-		for (auto activity : m_activities)
+		for (Activity* activity : preferredActivities)
 		{
-			m_availableSpots.push_back(activity);
-			activity->m_availableSpots.push_back(this);
-			activity->addPreferredStaff(this);
+			m_preferredActivities.push_back(getSpotId(*activity));
+			m_availableSpots.push_back(getSpotId(*activity));
+			activity->m_availableSpots.push_back(getSpotId(*this));
+			activity->addPreferredStaff(getSpotId(*this));
 		}
 	}
 
 	//adds list of neutral activities to this staff member and adds this staff to the neutral staff of each of those activities
-	void setNeutralActivities(std::vector<Activity*> neutralActivities)
+	void setNeutralActivities(const std::vector<Activity*>& neutralActivities)
 	{
-		m_neutralActivities = std::move(neutralActivities);
-		for (auto activity : m_activities)
+		for (Activity* activity : neutralActivities)
 		{
-			m_availableSpots.push_back(activity);
-			activity->m_availableSpots.push_back(this);
-			activity->addNeutralStaff(this);
+			m_neutralActivities.push_back(getSpotId(*activity));
+			m_availableSpots.push_back(getSpotId(*activity));
+			activity->m_availableSpots.push_back(getSpotId(*this));
+			activity->addNeutralStaff(getSpotId(*this));
 		}
 	}
 
 	//adds list of unpreferred activities to this staff member and adds this staff to the unpreferred staff of each of those activities
-	void setUnpreferredActivities(std::vector<Activity*> unpreferredActivities)
+	void setUnpreferredActivities(const std::vector<Activity*>& unpreferredActivities)
 	{
-		m_unpreferredActivities = std::move(unpreferredActivities);
-		for (auto activity : m_activities)
+		for (Activity* activity : unpreferredActivities)
 		{
-			m_availableSpots.push_back(activity);
-			activity->m_availableSpots.push_back(this);
-			activity->addUnpreferredStaff(this);
+			m_unpreferredActivities.push_back(getSpotId(*activity));
+			m_availableSpots.push_back(getSpotId(*activity));
+			activity->m_availableSpots.push_back(getSpotId(*this));
+			activity->addUnpreferredStaff(getSpotId(*this));
 		}
 	}
 
 	//adds list of available schedule slots to this staff member and adds this staff to the avaialble staff of each of those schedule slots
-	void setTimesAvailable(std::vector<ScheduleSlot*> timesAvailable)
+	void setTimesAvailable(const std::vector<ScheduleSlot*>& timesAvailable)
 	{
-		m_timesAvailable = std::move(timesAvailable);
-		for (auto slot : m_timesAvailable)
+		for (ScheduleSlot* slot : timesAvailable)
 		{
-			m_availableSpots.push_back(slot);
-			slot->m_availableSpots.push_back(this);
-			slot->addPossibleStaff(this);
+			m_timesAvailable.push_back(getSpotId(*slot));
+			m_slotMask.set(slot->getID());
+			m_availableSpots.push_back(getSpotId(*slot));
+			slot->m_availableSpots.push_back(getSpotId(*this));
+			slot->addPossibleStaff(getSpotId(*this));
 		}
 	}
 public:
 
-	//Staff constructor, initializes name, available activity lists, slots available list, times per cycle and id
-	Staff(const std::string_view name, const int timesPerCycle, std::vector <Activity*>& preferredActivities, std::vector <Activity*>& neutralActivities, std::vector <Activity*>& unpreferredActivities, std::vector<ScheduleSlot*>& slots)
-		: m_name{ name }
+	//Staff constructor, initializes name, available activity lists, slots available list, workload limits and id
+	//a staff member can be given up to their maximum load, so it is their times per cycle
+	Staff(const std::string_view name, const StaffLimits& limits, std::vector <Activity*>& preferredActivities, std::vector <Activity*>& neutralActivities, std::vector <Activity*>& unpreferredActivities, std::vector<ScheduleSlot*>& slots, const int id)
+		: m_name{ name },
+		m_limits{ limits }
 	{
+		m_id = id; //set first since the activities and slots are given this staff member's ID
 		setPreferredActivities(preferredActivities);
 		setNeutralActivities(neutralActivities);
 		setUnpreferredActivities(unpreferredActivities);
 		setTimesAvailable(slots);
-		m_timesPerCycle = timesPerCycle;
-		m_timesLeftPerCycle = timesPerCycle;
-		m_id = id; //assings object's unique id as next id to add
-		++id; //iterates Spotwrapper ID to ensure each object has a unique ID
+		m_timesPerCycle = limits.maximumLoad;
+		m_timesLeftPerCycle = limits.maximumLoad;
+		updateSortKey();
+	}
+
+	//gets this staff member's name
+	constexpr std::string_view getName() const
+	{
+		return m_name;
+	}
+
+	//gets the limits on this staff member's workload
+	constexpr const StaffLimits& getLimits() const
+	{
+		return m_limits;
+	}
+
+	//gets whether another staff member has led the same number of slots at the same periods, so their limits prune the same slots from here on
+	bool hasSameWorkload(const Staff& other) const
+	{
+		return m_load == other.m_load && m_periodsOnDay == other.m_periodsOnDay && m_busyPeriods == other.m_busyPeriods;
+	}
+
+	//sets the limits on this staff member's workload, before any slots are counted towards them
+	void setLimits(const StaffLimits& limits)
+	{
+		m_limits = limits;
+	}
+
+	//gets the number of slots this staff member leads
+	constexpr int getLoad() const
+	{
+		return m_load;
 	}
 
+	void addWorkload(const int time, SpotTable& spots, const ScheduleSlot* filledSlot = nullptr);
+
 	//gets number of options to be discarded before filling the spot
 	constexpr std::pair<int, int> getNumberToDiscard() const
 	{
@@ -669,19 +1041,19 @@ public:
 	}
 
 	//gets m_preferredActivities array
-	std::vector <Activity*>& getPreferredActivities()
+	SpotList<Activity>& getPreferredActivities()
 	{
 		return m_preferredActivities;
 	}
 
 	//gets m_neutralActivities array
-	std::vector <Activity*>& getNeutralActivities()
+	SpotList<Activity>& getNeutralActivities()
 	{
 		return m_neutralActivities;
 	}
 
 	//gets m_unpreferredActivities array
-	std::vector <Activity*>& getUnpreferredActivities()
+	SpotList<Activity>& getUnpreferredActivities()
 	{
 		return m_unpreferredActivities;
 	}
@@ -689,11 +1061,80 @@ public:
 
 };
 
-int SpotWrapper::id{ 0 }; //initiailize the starting id of the SpotWrapper class
 
 
 
 
+//turns the IDs in the spots' lists back into the spots of one copy of a roster
+//activities and staff are always copied whole, so they are found from their offset from the first ID
+//slots are found through an index since a participant group only copies some of them
+class SpotTable
+{
+	std::vector<ScheduleSlot>& m_scheduleSlots; //the slots of this copy
+	std::vector<Activity>& m_activities; //the activities of this copy, in ID order
+	std::vector<Staff>& m_staff; //the staff of this copy, in ID order
+	std::array<int, SlotMask::size> m_slotIndex{}; //the index of each slot in m_scheduleSlots by ID, -1 for slots not in this copy
+
+	//finds the spot with a given ID in a list in ID order, nullptr if it is not in the list
+	//a list with every ID from its first is indexed directly, one which leaves some spots out is searched
+	template <typename Spot>
+	static Spot* find(std::vector<Spot>& spots, const int id)
+	{
+		if (spots.empty())
+			return nullptr;
+		std::size_t index{ static_cast<std::size_t>(id - spots[0].getID()) };
+		if (index < spots.size() && spots[index].getID() == id)
+			return &spots[index];
+		auto found{ std::lower_bound(spots.begin(), spots.end(), id, [](const Spot& spot, const int spotID)
+			{
+				return spot.getID() < spotID;
+			}) };
+		return found != spots.end() && found->getID() == id ? &*found : nullptr;
+	}
+
+public:
+
+	//creates a table of the given spots, which must not be added to or removed from while the table is used
+	SpotTable(std::vector<ScheduleSlot>& scheduleSlots, std::vector<Activity>& activities, std::vector<Staff>& staff)
+		: m_scheduleSlots{ scheduleSlots },
+		m_activities{ activities },
+		m_staff{ staff }
+	{
+		m_slotIndex.fill(-1);
+		for (std::size_t index{ 0 }; index < m_scheduleSlots.size(); ++index)
+			m_slotIndex[m_scheduleSlots[index].getID()] = static_cast<int>(index);
+	}
+
+	//gets the slot with a given ID, nullptr if it is not in this copy
+	ScheduleSlot* get(const SlotId id)
+	{
+		return id.get() < numberOfSlotIDs && m_slotIndex[id.get()] != -1 ? &m_scheduleSlots[m_slotIndex[id.get()]] : nullptr;
+	}
+
+	//gets the activity with a given ID, nullptr if it is not in this copy
+	Activity* get(const ActivityId id)
+	{
+		return find(m_activities, id.get());
+	}
+
+	//gets the staff member with a given ID, nullptr if they are not in this copy
+	Staff* get(const StaffId id)
+	{
+		return find(m_staff, id.get());
+	}
+
+	//gets the spot of any type with a given ID, the type is found from which range of IDs it is in
+	//staff IDs follow every activity ID, so a staff member left out of this copy is looked for among the activities and not found
+	SpotWrapper* get(const SpotId<SpotWrapper> id)
+	{
+		if (id.get() < numberOfSlotIDs)
+			return get(SlotId{ id.get() });
+		if (!m_staff.empty() && id.get() >= m_staff[0].getID())
+			return get(StaffId{ id.get() });
+		return get(ActivityId{ id.get() });
+	}
+};
+
 //removes this spot from the lists of a given spot
 void SpotWrapper::remove(SpotWrapper* spot)
 {
@@ -702,37 +1143,69 @@ void SpotWrapper::remove(SpotWrapper* spot)
 	if (spot->getType() == Type::ScheduleSlot)
 	{
 		removeSpot(static_cast<ScheduleSlot*>(spot), m_timesAvailable);
+		m_slotMask.reset(spot->getID());
 	}
 	else
 	{
 		removeFromThis(spot);
 	}
+	updateSortKey(); //this spot has one less option so it may need to be filled sooner
 }
 
 
 
-//adds a given spot to this spot and removes this spot from other spots if it has been filled
-void SpotWrapper::add(SpotWrapper* spot)
+//rebuilds the slot mask from the times available list after the list has been replaced
+void SpotWrapper::rebuildSlotMask()
+{
+	m_slotMask.clear();
+	for (SlotId slot : m_timesAvailable)
+		m_slotMask.set(slot.get());
+}
+
+//adds a given spot to this spot and removes this spot from other spots if it has been filled, the spots this spot refers to are looked up in a given table
+void SpotWrapper::add(SpotWrapper* spot, SpotTable& spots)
+{
+	record(spot, spots);
+	countFilled(spots);
+}
+
+//adds a given spot to the lists of spots filling this spot, without counting it towards this spot's times
+void SpotWrapper::record(SpotWrapper* spot, SpotTable& spots)
 {
 	if (spot->getType() == Type::Activity)
 	{
-		m_activities.push_back(static_cast<Activity*>(spot));
+		m_activities.push_back(ActivityId{ spot->getID() });
 	}
 	else if (spot->getType() == Type::ScheduleSlot)
 	{
-		m_slots.push_back(static_cast<ScheduleSlot*>(spot));
-		//removes staff from list of availableStaff at the schedule slors at the same as the one they are being added to
-		for (ScheduleSlot* slot : m_slots[m_slots.size() - 1]->getSlotsAtSameTime())
+		m_slots.push_back(SlotId{ spot->getID() });
+		//the other slots at the same time can no longer be filled with this spot, which are found by their IDs rather than stored
+		int time{ static_cast<ScheduleSlot*>(spot)->getTime() };
+		for (int level{ 0 }; level < static_cast<int>(Level::maxLevel); ++level)
 		{
+			SlotId slotID{ getSlotID(level, time) };
+			if (slotID.get() == spot->getID() || !m_timesAvailable.contains(slotID))
+				continue;
+			ScheduleSlot* slot{ spots.get(slotID) };
+			if (slot == nullptr)
+				continue;
 			slot->remove(this);
-  }
+			if (getType() == Type::Staff) //a staff member can no longer lead them either, this is the only place that is done so addWorkload leaves it out
+				remove(slot);
+		}
+		if (getType() == Type::Staff) //counts the slot towards the staff member's workload limits
+			static_cast<Staff*>(this)->addWorkload(static_cast<ScheduleSlot*>(spot)->getTime(), spots, static_cast<ScheduleSlot*>(spot));
 	}
 
 	else
 	{
-		m_staff.push_back(static_cast<Staff*>(spot));
+		m_staff.push_back(StaffId{ spot->getID() });
 	}
+}
 
+//counts one more time this spot has been filled, and removes this spot from the possible lists of all its possible spots once it is full
+void SpotWrapper::countFilled(SpotTable& spots)
+{
 	--m_timesLeftPerCycle; //decreases the times left to add to this spot
 
 	//if this spot is full, remove it from the possible list of all its possible spot
@@ -740,708 +1213,5029 @@ void SpotWrapper::add(SpotWrapper* spot)
 	{
 		m_completed = true;
 
-		for (SpotWrapper* availableSpot : m_availableSpots)
-			availableSpot->remove(this);
+		for (SpotId<SpotWrapper> availableID : m_availableSpots)
+		{
+			SpotWrapper* availableSpot{ spots.get(availableID) };
+			if (availableSpot != nullptr) //spots outside this copy of the roster have nothing to remove
+				availableSpot->remove(this);
+		}
 	}
+	updateSortKey();
 }
 
-class FillSpot
+//removes the slots at the given times from this staff member and this staff member from those slots, except for a slot being filled
+template <typename Function>
+void Staff::removeSlotsWhere(Function atTime, SpotTable& spots, const ScheduleSlot* filledSlot)
 {
-
-	//prevents typos from causes bugs
-	enum sortDirection //possible sort directions of update sort
+	//the slots are found first since removing a slot reorders the list being searched
+	std::vector<SlotId> removed{};
+	for (SlotId slot : m_timesAvailable)
 	{
-		either,
-		decreased
-	};
+		if ((filledSlot == nullptr || slot.get() != filledSlot->getID()) && atTime(getSlotTime(slot.get())))
+			removed.push_back(slot);
+	}
+	for (SlotId slotID : removed)
+	{
+		ScheduleSlot* slot{ spots.get(slotID) };
+		if (slot == nullptr)
+			continue;
+		slot->remove(this);
+		remove(slot);
+	}
+}
 
-	std::vector < SpotWrapper*> m_spotsToBeFilled; //Holds all the activities and schedule slots to be filled
-	std::vector <Activity> m_activities; //Holds activities and ensures their existence for the lifetime of the class
-	std::vector <ScheduleSlot> m_scheduleSlots; //Holds schedule slots and ensures their existence for the lifetime of the class
-	std::vector <Staff> m_staff; //Holds staff and ensures their existence for the lifetime of the class
+//counts a slot at the given time towards this staff member's workload and removes the slots their limits no longer allow them to lead
+//the other slots at the same time are removed by SpotWrapper::record rather than here
+//each rule is checked with constant time counters: the load, a count per day and the bits of the periods led each day
+void Staff::addWorkload(const int time, SpotTable& spots, const ScheduleSlot* filledSlot)
+{
+	int day{ time / periodsInDay };
+	int period{ time % periodsInDay };
+	++m_load;
+	++m_periodsOnDay[day];
+	m_busyPeriods[day] |= 1u << period;
 
-	//returns whether the spot at the given index of the spots to be filled array is available within a given spot
-	bool foundIndex(SpotWrapper* spot, int index)
+	if (m_load >= m_limits.maximumLoad) //no more slots can be led at all
 	{
-		if (std::find(spot->getAvailableSpots().begin(), spot->getAvailableSpots().end(), m_spotsToBeFilled[index]) == spot->getAvailableSpots().end())
-			return false;
-		return true;
+		removeSlotsWhere([](int) { return true; }, spots, filledSlot);
+		return;
+	}
+	if (m_periodsOnDay[day] >= m_limits.dailyCap) //no more slots can be led on this day
+	{
+		removeSlotsWhere([day](int slotTime) { return slotTime / periodsInDay == day; }, spots, filledSlot);
+		return;
 	}
 
-	std::size_t m_nextIndex{ 0 };
+	//only the free periods on either side of the run containing this period can now make a run too long
+	int first{ period - getRunBelow(day, period) };
+	int last{ period + getRunAbove(day, period) };
+	for (int freePeriod : { first - 1, last + 1 })
+	{
+		if (freePeriod < 0 || freePeriod >= periodsInDay)
+			continue;
+		if (getRunBelow(day, freePeriod) + 1 + getRunAbove(day, freePeriod) > m_limits.maxConsecutive)
+		{
+			int blockedTime{ day * periodsInDay + freePeriod };
+			removeSlotsWhere([blockedTime](int slotTime) { return slotTime == blockedTime; }, spots, filledSlot);
+		}
+	}
+}
 
-	//gets the spot with the lowest index belonging to a given spot
-	SpotWrapper* getNext(SpotWrapper* spot)
+//an assignment fixed before filling starts (e.g. locked in by a director), stored by spot ID so it survives copies of the spots
+struct LockedAssignment
+{
+	int slotID{}; //ID of the schedule slot being locked
+	int activityID{}; //ID of the activity locked into the slot
+	int staffID{}; //ID of the staff member locked into the slot
+};
+
+//the filled schedule stored as flat arrays indexed by schedule slot ID, unfilled slots hold -1
+struct Schedule
+{
+	std::vector<int> activityIDs{}; //ID of the activity filling each slot
+	std::vector<int> staffIDs{}; //ID of the staff member filling each slot, who leads its team
+	std::vector<std::vector<int>> assistantIDs{}; //IDs of the rest of each slot's team, empty unless its participants need more than one staff member
+	std::vector<int> fillOrder{}; //IDs of the filled slots in the order the fills decided them, so a schedule can be refilled from any point of its decisions
+
+	Schedule() = default;
+
+	//creates an empty schedule with the given number of schedule slots
+	explicit Schedule(const std::size_t numberOfSlots)
+		: activityIDs(numberOfSlots, -1),
+		staffIDs(numberOfSlots, -1),
+		assistantIDs(numberOfSlots)
 	{
-		if (m_nextIndex != 0)
-			++m_nextIndex;
-		try
+	}
+
+	//records the activity and staff member filling the slot with the given ID, replacing any team it had
+	void assign(const int slotID, const int activityID, const int staffID)
+	{
+		activityIDs[slotID] = activityID;
+		staffIDs[slotID] = staffID;
+		assistantIDs[slotID].clear();
+	}
+
+	//adds a staff member to the team of the slot with the given ID, after its lead has been assigned
+	void addAssistant(const int slotID, const int staffID)
+	{
+		assistantIDs[slotID].push_back(staffID);
+	}
+
+	//calls a given function with the ID of each staff member on the team of the slot with the given ID, lead first
+	template <typename Function>
+	void forEachStaff(const int slotID, Function function) const
+	{
+		if (staffIDs[slotID] == -1)
+			return;
+		function(staffIDs[slotID]);
+		for (int assistantID : assistantIDs[slotID])
+			function(assistantID);
+	}
+
+	//gets whether the slot with the given ID has been filled
+	bool isFilled(const int slotID) const
+	{
+		return activityIDs[slotID] != -1;
+	}
+};
+
+//options which control a solver run, read in from the command line
+struct SolverOptions
+{
+	std::optional<std::uint32_t> seed{}; //seed for the random number generator, generated from the OS's random device if not given
+	std::optional<std::string> socketPath{}; //path of the socket to serve requests on, runs a single solve if not given
+	std::optional<std::string> batchPath{}; //directory or manifest of rosters to solve at the same time, runs a single solve if not given
+	std::optional<std::string> scenarioPath{}; //csv of what-if scenarios of "scheduling.csv" to solve at the same time, runs a single solve if not given
+	unsigned int workers{ std::max(1u, std::thread::hardware_concurrency()) }; //number of threads solving requests in server or batch mode
+	bool matching{ false }; //fills all the slots at each time at once with a min cost matching rather than one spot at a time
+	bool symmetry{ true }; //treats interchangeable activities and staff as one spot while searching
+	bool benchmark{ false }; //runs the availability microbenchmark instead of solving
+	std::optional<double> timeLimit{}; //seconds a solve can run before it returns the schedule filled so far, no limit if not given
+	std::optional<std::uint64_t> iterationLimit{}; //number of spots a solve can try to fill before it returns the schedule filled so far, no limit if not given
+	bool progress{ false }; //writes progress events to the error stream while solving
+	int neighbourhoodIterations{ 0 }; //iterations of large neighbourhood search run on the filled schedule, none if not given
+	bool byDay{ false }; //fills each day separately and at the same time rather than blocks of slots with the same number of participants
+	int poolSize{ 1 }; //number of alternative schedules to find for the director to choose between, the best of them is the solved schedule
+	int poolDistance{ 10 }; //fewest slots in which each schedule of a pool must differ from every better one
+	bool criticality{ false }; //re-solves without each staff member to rank how critical they are instead of writing a schedule
+	bool activityCriticality{ false }; //ranks the activities as well as the staff in a criticality analysis
+};
+
+//the quality of a schedule, a schedule with fewer unfilled slots is better and ties go to the schedule giving staff the activities they prefer
+struct ScheduleScore
+{
+	int unfilledSlots{ 0 }; //number of slots with no activity and staff
+	int preferenceCost{ 0 }; //0 for each slot led by a staff member who prefers its activity, 1 if they are neutral and 2 if they prefer not to
+
+	//returns whether this score is better than a given score
+	bool isBetterThan(const ScheduleScore& other) const
+	{
+		if (unfilledSlots != other.unfilledSlots)
+			return unfilledSlots < other.unfilledSlots;
+		return preferenceCost < other.preferenceCost;
+	}
+};
+
+//adds the score of the slot with a given ID to a score, or takes it away when sign is -1
+//activity IDs are consecutive from the first activity's ID so they can be used as indices
+//note activities is non const since the preference lists are looked up through their getters
+void addSlotScore(ScheduleScore& score, const Schedule& schedule, const int slotID, std::vector<Activity>& activities, const int sign = 1)
+{
+	if (!schedule.isFilled(slotID))
+	{
+		score.unfilledSlots += sign;
+		return;
+	}
+	Activity& activity{ activities[schedule.activityIDs[slotID] - activities[0].getID()] };
+	StaffId staffID{ schedule.staffIDs[slotID] };
+	if (!activity.getPreferredStaff().contains(staffID))
+		score.preferenceCost += sign * (activity.getNeutralStaff().contains(staffID) ? 1 : 2);
+}
+
+//scores a schedule
+ScheduleScore scoreSchedule(const Schedule& schedule, std::vector<Activity>& activities)
+{
+	ScheduleScore score{};
+	for (std::size_t slotID{ 0 }; slotID < schedule.activityIDs.size(); ++slotID)
+		addSlotScore(score, schedule, static_cast<int>(slotID), activities);
+	return score;
+}
+
+//the progress of a solve, reported while filling
+struct SolveProgress
+{
+	int slotsFilled{ 0 }; //number of slots filled so far, including locked slots
+	int retries{ 0 }; //number of times a spot could not be filled and the fill lists were changed to try again
+	ScheduleScore best{}; //score of the best schedule recorded so far
+	double seconds{ 0.0 }; //time since the solve started
+	int day{ -1 }; //the day this is the progress of when the days are filled separately, -1 for the whole solve
+};
+
+//bounds how long a solve can run and reports its progress, the fill loops count a step before each spot they try to fill
+//the clock is only read every few steps so that checking the budget costs about as much as incrementing a counter
+class SolveBudget
+{
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr std::uint64_t stepsPerClockRead{ 64 }; //steps between reads of the clock
+	static constexpr std::chrono::milliseconds reportInterval{ 500 }; //time between progress reports
+
+	Clock::time_point m_start{ Clock::now() }; //when the solve started
+	std::optional<Clock::time_point> m_deadline{}; //when the solve must stop, none if there is no time limit
+	std::optional<std::uint64_t> m_stepLimit{}; //number of steps the solve can take, none if there is no iteration limit
+	std::uint64_t m_steps{ 0 }; //number of steps taken
+	bool m_exhausted{ false }; //stores whether the time or iteration limit has been reached
+	std::function<void(const SolveProgress&)> m_report{}; //called with the progress every report interval, none if progress is not reported
+	Clock::time_point m_nextReport{ m_start + reportInterval }; //when progress is next reported
+
+public:
+
+	SolveProgress progress{}; //updated by the fill loops as they fill slots
+
+	//creates a budget with the given time limit in seconds and iteration limit, either of which can be none
+	explicit SolveBudget(const std::optional<double> timeLimit, const std::optional<std::uint64_t> iterationLimit, std::function<void(const SolveProgress&)> report = {})
+		: m_stepLimit{ iterationLimit },
+		m_report{ std::move(report) }
+	{
+		if (timeLimit)
+			m_deadline = m_start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>{ *timeLimit });
+	}
+
+	//counts a step, returns false once the budget has been used up so the caller stops and keeps what it has filled
+	bool step()
+	{
+		if (m_exhausted)
+			return false;
+		if (m_stepLimit && m_steps >= *m_stepLimit)
 		{
-			while (foundIndex(spot, m_nextIndex))
-				++m_nextIndex;
+			m_exhausted = true;
+			return false;
 		}
-		catch (...)
+		if (++m_steps % stepsPerClockRead != 0 || (!m_deadline && !m_report))
+			return true;
+
+		Clock::time_point now{ Clock::now() };
+		if (m_deadline && now >= *m_deadline)
 		{
-			throw "Nothing can fill this spot";
+			m_exhausted = true;
+			return false;
 		}
-		return m_spotsToBeFilled[m_nextIndex];
+		if (m_report && now >= m_nextReport)
+		{
+			m_nextReport = now + reportInterval;
+			report();
+		}
+		return true;
 	}
 
-	//gets the spot with the lowest index belonging to the union of two given spots
-	SpotWrapper* getFirst(SpotWrapper* spot1, SpotWrapper* spot2)
+	//creates a budget for one of a given number of parts of this solve which run at the same time on other threads, reporting through this budget's reporter
+	//the parts can run until a given fraction of the time left has passed and split that fraction of the steps left between them, so the rest is left for this budget
+	SolveBudget share(const int parts, const double fraction, const int day) const
 	{
-		std::size_t index{ 0 };
-		try
+		SolveBudget part{ *this }; //keeps the start time and reporter so its reports read like this budget's
+		Clock::time_point now{ Clock::now() };
+		if (m_deadline)
+			part.m_deadline = now + std::chrono::duration_cast<Clock::duration>((std::max(*m_deadline, now) - now) * fraction);
+		if (m_stepLimit)
+			part.m_stepLimit = static_cast<std::uint64_t>(static_cast<double>(*m_stepLimit - std::min(m_steps, *m_stepLimit)) * fraction) / static_cast<std::uint64_t>(parts);
+		part.m_steps = 0;
+		part.m_nextReport = now + reportInterval;
+		part.progress = {};
+		part.progress.day = day;
+		return part;
+	}
+
+	//counts the steps and progress of a budget used by part of this solve on another thread
+	//a part which used up its share has not used up this budget, which stops by its own limits
+	void add(const SolveBudget& other)
+	{
+		m_steps += other.m_steps;
+		m_exhausted = m_exhausted || (m_stepLimit && m_steps >= *m_stepLimit);
+		progress.slotsFilled += other.progress.slotsFilled;
+		progress.retries += other.progress.retries;
+	}
+
+	//returns whether the time or iteration limit was reached
+	bool isExhausted() const
+	{
+		return m_exhausted;
+	}
+
+	//reports the current progress if progress is being reported
+	void report()
+	{
+		if (!m_report)
+			return;
+		progress.seconds = std::chrono::duration<double>(Clock::now() - m_start).count();
+		m_report(progress);
+	}
+};
+
+//writes a progress event to the error stream as one line
+void writeProgress(const SolveProgress& progress)
+{
+	std::ostringstream line{};
+	line << "progress ";
+	if (progress.day != -1)
+		line << "day " << progress.day + 1 << ", ";
+	line << std::fixed << std::setprecision(2) << progress.seconds << "s, " << progress.slotsFilled << " slots filled, " << progress.retries << " retries, best " << progress.best.unfilledSlots << " unfilled with preference cost " << progress.best.preferenceCost << '\n';
+	std::cerr << line.str(); //written in one call so lines from concurrent solves do not interleave
+}
+
+//groups of interchangeable activities or staff, which have identical times per cycle, availability and preferences
+struct SymmetryClasses
+{
+	std::vector<int> classOf{}; //the class of each spot by ID, -1 for spots which are not interchangeable with any other spot
+	std::vector<std::vector<int>> members{}; //the IDs of the spots in each class, the multiplicity of a class is its number of members
+	std::vector<bool> staffClass{}; //whether each class holds staff rather than activities
+
+	//gets whether two spots belong to the same class
+	bool areEquivalent(const SpotWrapper* spot1, const SpotWrapper* spot2) const
+	{
+		int class1{ spot1->getID() < static_cast<int>(classOf.size()) ? classOf[spot1->getID()] : -1 };
+		return class1 != -1 && spot2->getID() < static_cast<int>(classOf.size()) && class1 == classOf[spot2->getID()];
+	}
+};
+
+//adds the sorted IDs of a given list of spots to a given signature, followed by a divider
+template <typename T>
+void appendSignatureIDs(std::vector<int>& signature, const SpotList<T>& spots)
+{
+	std::size_t start{ signature.size() };
+	for (SpotId<T> spot : spots)
+		signature.push_back(spot.get());
+	std::sort(signature.begin() + start, signature.end());
+	signature.push_back(-1);
+}
+
+//gets the number of spot IDs used by a roster, IDs are given to the slots, then the activities, then the staff so the last spot read in has the largest
+int getNumberOfSpotIDs(const std::vector<Activity>& activities, const std::vector<Staff>& staff)
+{
+	if (!staff.empty())
+		return staff.back().getID() + 1;
+	if (!activities.empty())
+		return activities.back().getID() + 1;
+	return numberOfSlotIDs;
+}
+
+//groups the activities and staff which cannot be told apart into symmetry classes
+//spots are compared by a signature of their type, times per cycle, staff ratio or workload limits, sorted available slot IDs and sorted preference lists
+SymmetryClasses findSymmetryClasses(std::vector <Activity>& activities, std::vector <Staff>& staff)
+{
+	std::map<std::vector<int>, std::vector<int>> groups{}; //the IDs of the spots with each signature
+
+	for (Activity& activity : activities)
+	{
+		std::vector<int> signature{ 0, activity.getTimesPerCycle(), activity.getStaffRatio().campersPerStaff, activity.getStaffRatio().minimumStaff };
+		appendSignatureIDs(signature, activity.getTimesAvailable());
+		appendSignatureIDs(signature, activity.getPreferredStaff());
+		appendSignatureIDs(signature, activity.getNeutralStaff());
+		appendSignatureIDs(signature, activity.getUnpreferredStaff());
+		groups[signature].push_back(activity.getID());
+	}
+
+	for (Staff& member : staff)
+	{
+		const StaffLimits& limits{ member.getLimits() };
+		std::vector<int> signature{ 1, member.getTimesPerCycle(), limits.minimumLoad, limits.maximumLoad, limits.dailyCap, limits.maxConsecutive };
+		appendSignatureIDs(signature, member.getTimesAvailable());
+		appendSignatureIDs(signature, member.getPreferredActivities());
+		appendSignatureIDs(signature, member.getNeutralActivities());
+		appendSignatureIDs(signature, member.getUnpreferredActivities());
+		groups[signature].push_back(member.getID());
+	}
+
+	SymmetryClasses classes{};
+	classes.classOf.assign(getNumberOfSpotIDs(activities, staff), -1);
+	for (auto& [signature, members] : groups)
+	{
+		if (members.size() < 2) //a spot with no equivalent spot does not need a class
+			continue;
+		for (int id : members)
+			classes.classOf[id] = static_cast<int>(classes.members.size());
+		classes.members.push_back(std::move(members));
+		classes.staffClass.push_back(signature[0] == 1);
+	}
+	return classes;
+}
+
+//the solver treats the members of a class as one spot, so which member fills which slot is arbitrary
+//spreads each class's slots over its members, fewest slots first, leaving locked slots with the member they were locked to
+//staff are only given a slot within their workload limits, and a class which cannot be spread within them, or would leave a member short of a minimum load the solver met, keeps the members the solver chose
+void expandSymmetryClasses(Schedule& schedule, const SymmetryClasses& classes, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments)
+{
+	constexpr int numberOfTimes{ daysInCycle * periodsInDay };
+	int firstStaffID{ staff.empty() ? 0 : staff[0].getID() };
+	std::vector<bool> locked(schedule.activityIDs.size(), false);
+	for (const LockedAssignment& lockedAssignment : lockedAssignments)
+		locked[lockedAssignment.slotID] = true;
+
+	for (std::size_t classIndex{ 0 }; classIndex < classes.members.size(); ++classIndex)
+	{
+		const std::vector<int>& members{ classes.members[classIndex] };
+		bool staffClass{ classes.staffClass[classIndex] };
+		std::vector<int>& assigned{ staffClass ? schedule.staffIDs : schedule.activityIDs };
+		auto getMember{ [&members](const int id)
+			{
+				return static_cast<std::size_t>(std::find(members.begin(), members.end(), id) - members.begin());
+			} };
+
+		std::vector<int> load(members.size(), 0); //the number of slots given to each member
+		std::vector<int> solvedLoad(members.size(), 0); //the number of slots the solver gave each member
+		std::vector<std::bitset<numberOfTimes>> busy(members.size()); //the times each member already fills a slot at
+		std::array<std::vector<int>, numberOfTimes> slotsAtTime{}; //the unlocked slots of this class at each time
+		if (staffClass) //assistants keep their slots, so like locked leads they are busy at those times
 		{
-			while (!foundIndex(spot1, index) || !foundIndex(spot2, index))
-				++index;
+			for (std::size_t slotID{ 0 }; slotID < schedule.assistantIDs.size(); ++slotID)
+			{
+				for (int assistantID : schedule.assistantIDs[slotID])
+				{
+					if (classes.classOf[assistantID] != static_cast<int>(classIndex))
+						continue;
+					std::size_t member{ getMember(assistantID) };
+					++load[member];
+					++solvedLoad[member];
+					busy[member].set(static_cast<int>(slotID) % numberOfTimes);
+				}
+			}
 		}
-		catch (...)
+		for (std::size_t slotID{ 0 }; slotID < assigned.size(); ++slotID)
 		{
-			return nullptr;
+			if (assigned[slotID] == -1 || classes.classOf[assigned[slotID]] != static_cast<int>(classIndex))
+				continue;
+			std::size_t member{ getMember(assigned[slotID]) };
+			++solvedLoad[member];
+			if (locked[slotID])
+			{
+				++load[member];
+				busy[member].set(static_cast<int>(slotID) % numberOfTimes);
+			}
+			else
+				slotsAtTime[static_cast<int>(slotID) % numberOfTimes].push_back(static_cast<int>(slotID));
 		}
-		return m_spotsToBeFilled[index];
+
+		//gets whether a member can fill one more slot at a given time, activities have no limits beyond one slot at a time
+		auto canFill{ [&](const std::size_t member, const int time)
+			{
+				if (busy[member][time])
+					return false;
+				if (!staffClass)
+					return true;
+				const StaffLimits& limits{ staff[static_cast<std::size_t>(members[member] - firstStaffID)].getLimits() };
+				int day{ time / periodsInDay };
+				int period{ time % periodsInDay };
+				int onDay{ 0 };
+				for (int other{ 0 }; other < periodsInDay; ++other)
+					onDay += busy[member][day * periodsInDay + other];
+				int run{ 1 }; //the periods in a row the member would lead with this slot
+				for (int before{ period - 1 }; before >= 0 && busy[member][day * periodsInDay + before]; --before)
+					++run;
+				for (int after{ period + 1 }; after < periodsInDay && busy[member][day * periodsInDay + after]; ++after)
+					++run;
+				return load[member] < limits.maximumLoad && onDay < limits.dailyCap && run <= limits.maxConsecutive;
+			} };
+
+		std::vector<int> spread{ assigned }; //the members given to the slots, only kept once every slot has one
+		bool spreadAll{ true };
+		for (int time{ 0 }; time < numberOfTimes && spreadAll; ++time)
+		{
+			for (int slotID : slotsAtTime[time])
+			{
+				//gives the slot to the member with the fewest slots who can fill it
+				std::size_t chosen{ members.size() };
+				for (std::size_t member{ 0 }; member < members.size(); ++member)
+				{
+					if (canFill(member, time) && (chosen == members.size() || load[member] < load[chosen]))
+						chosen = member;
+				}
+				if (chosen == members.size())
+				{
+					spreadAll = false;
+					break;
+				}
+				spread[static_cast<std::size_t>(slotID)] = members[chosen];
+				busy[chosen].set(time);
+				++load[chosen];
+			}
+		}
+
+		for (std::size_t member{ 0 }; member < members.size() && staffClass && spreadAll; ++member)
+		{
+			int minimumLoad{ staff[static_cast<std::size_t>(members[member] - firstStaffID)].getLimits().minimumLoad };
+			if (load[member] < minimumLoad && solvedLoad[member] >= minimumLoad)
+				spreadAll = false;
+		}
+		if (spreadAll)
+			assigned = std::move(spread);
 	}
+}
 
-	//updates the spots to be filled list and its members indices
-	void updateSpotsToBeFilled()
+//a slot, the activity filling it and the staff member leading it chosen by the time period matcher
+struct MatchedTriple
+{
+	int slot{}; //index of the slot in the matcher
+	int activity{}; //index of the activity in the matcher
+	int staff{}; //index of the staff member in the matcher
+	int cost{}; //cost of the staff member leading the activity
+};
+
+//finds the cheapest set of triples filling as many of the slots at one time as possible, with no slot, activity or staff member in two triples
+//solved as a min cost flow (source -> slot -> activity in -> activity out -> staff -> sink, each with capacity 1) using successive shortest paths
+//each activity is split into two nodes joined by one edge so it fills at most one slot, which makes every unit of flow a triple
+//a staff member can lead either every slot at a time of a fill or none of them, since their lists only lose slots by time, so staff need no edges to the slots
+class TimePeriodMatcher
+{
+	//an edge of the flow network, stored with the index of its reverse edge in the adjacency list of its destination
+	struct Edge
 	{
-		std::sort(m_spotsToBeFilled.begin(), m_spotsToBeFilled.end()); //sorts by how soon the slot should be filled
+		int to{};
+		int reverse{};
+		int capacity{};
+		int cost{};
+	};
 
-		std::size_t endOfCompleted{ 0 };
+	std::vector<std::vector<Edge>> m_graph{}; //adjacency lists of the flow network
+	int m_numberOfSlots{}; //slots are nodes 1 to m_numberOfSlots
+	int m_numberOfActivities{}; //the in nodes of the activities follow the slots, then their out nodes
+	int m_numberOfStaff{}; //staff are the nodes after the activities
 
-		//removes already filled spots from list
-		while (m_spotsToBeFilled[endOfCompleted]->getCompleted())
-			++endOfCompleted;
-		m_spotsToBeFilled.erase(m_spotsToBeFilled.begin(), m_spotsToBeFilled.begin() + endOfCompleted);
+	//adds an edge and its reverse residual edge to the network
+	void addEdge(const int from, const int to, const int cost)
+	{
+		m_graph[from].push_back({ to, static_cast<int>(m_graph[to].size()), 1, cost });
+		m_graph[to].push_back({ from, static_cast<int>(m_graph[from].size()) - 1, 0, -cost });
+	}
 
-		//updates the index of each spot to be filled
-		for (std::size_t index{ endOfCompleted }; index < m_spotsToBeFilled.size(); ++index)
-			m_spotsToBeFilled[index]->setIndex(index);
+	//gets the in node of an activity
+	int getActivityIn(const int activity) const
+	{
+		return m_numberOfSlots + activity + 1;
+	}
+
+	//gets the out node of an activity
+	int getActivityOut(const int activity) const
+	{
+		return m_numberOfSlots + m_numberOfActivities + activity + 1;
 	}
 
+	//gets the node of a staff member
+	int getStaffNode(const int staff) const
+	{
+		return m_numberOfSlots + 2 * m_numberOfActivities + staff + 1;
+	}
+
+	//gets the node of the sink
+	int getSink() const
+	{
+		return getStaffNode(m_numberOfStaff);
+	}
 
 public:
 
-	//initializes the fillspot list of schedule slots, activities and staff. Sorts by how soon the slot should be filled and assigns the respective index in that list to each spot
-	FillSpot(std::vector < Activity>& activities, std::vector < ScheduleSlot>& scheduleSlots, std::vector < Staff>& staff)
-		:m_activities{ std::move(activities) },//uses std::move for efficiency
-		m_scheduleSlots{ std::move(scheduleSlots) }, //uses std::move for efficiency
-		m_staff{ std::move(staff) }
+	//clears the network and adds the source and sink edges for the given number of slots, activities and staff
+	void reset(const int numberOfSlots, const int numberOfActivities, const int numberOfStaff)
 	{
+		m_numberOfSlots = numberOfSlots;
+		m_numberOfActivities = numberOfActivities;
+		m_numberOfStaff = numberOfStaff;
+		m_graph.assign(static_cast<std::size_t>(getSink()) + 1, {});
+		for (int slot{ 0 }; slot < numberOfSlots; ++slot)
+			addEdge(0, slot + 1, 0);
+		for (int staff{ 0 }; staff < numberOfStaff; ++staff)
+			addEdge(getStaffNode(staff), getSink(), 0);
+	}
 
-		for (Activity& activity : m_activities) //adds pointers to all activities to spotsToBeFilled
+	//allows a given activity to fill one slot at a given cost
+	void addActivity(const int activity, const int cost)
+	{
+		addEdge(getActivityIn(activity), getActivityOut(activity), cost);
+	}
+
+	//allows a given activity to fill a given slot
+	void addSlotActivity(const int slot, const int activity)
+	{
+		addEdge(slot + 1, getActivityIn(activity), 0);
+	}
+
+	//allows a given staff member to lead a given activity at a given preference cost
+	void addPair(const int activity, const int staff, const int cost)
+	{
+		addEdge(getActivityOut(activity), getStaffNode(staff), cost);
+	}
+
+	//finds the cheapest set of at most the given number of triples, in the order of their slots
+	std::vector<MatchedTriple> match(const int size)
+	{
+		const int numberOfNodes{ getSink() + 1 };
+		std::vector<int> distance(numberOfNodes);
+		std::vector<int> previousNode(numberOfNodes);
+		std::vector<int> previousEdge(numberOfNodes);
+		std::vector<bool> queued(numberOfNodes);
+		std::deque<int> queue{};
+
+		for (int flow{ 0 }; flow < size; ++flow)
 		{
-			m_spotsToBeFilled.push_back(&activity);
+			//finds the cheapest augmenting path, residual edges can have negative costs so shortest paths use SPFA
+			std::fill(distance.begin(), distance.end(), std::numeric_limits<int>::max());
+			distance[0] = 0;
+			queue.push_back(0);
+			queued[0] = true;
+			while (!queue.empty())
+			{
+				int node{ queue.front() };
+				queue.pop_front();
+				queued[node] = false;
+				for (std::size_t edgeIndex{ 0 }; edgeIndex < m_graph[node].size(); ++edgeIndex)
+				{
+					const Edge& edge{ m_graph[node][edgeIndex] };
+					if (edge.capacity > 0 && distance[node] + edge.cost < distance[edge.to])
+					{
+						distance[edge.to] = distance[node] + edge.cost;
+						previousNode[edge.to] = node;
+						previousEdge[edge.to] = static_cast<int>(edgeIndex);
+						if (!queued[edge.to])
+						{
+							queue.push_back(edge.to);
+							queued[edge.to] = true;
+						}
+					}
+				}
+			}
+
+			if (distance[getSink()] == std::numeric_limits<int>::max()) //no more slots can be given an activity and staff
+				break;
+
+			//pushes one unit of flow along the path
+			for (int node{ getSink() }; node != 0; node = previousNode[node])
+			{
+				Edge& edge{ m_graph[previousNode[node]][previousEdge[node]] };
+				--edge.capacity;
+				++m_graph[node][edge.reverse].capacity;
+			}
 		}
 
-		for (ScheduleSlot& scheduleSlot : m_scheduleSlots) //adds pointers to all scheduleSlots to spotsToBeFilled
+		//follows the used edge out of each slot to its activity, then the used edge out of the activity to its staff member
+		//the only edges from a slot to the activities, or from an activity to the staff, are forward edges, so a used one has no capacity left
+		std::vector<MatchedTriple> triples{};
+		for (int slot{ 0 }; slot < m_numberOfSlots; ++slot)
 		{
-			m_spotsToBeFilled.push_back(&scheduleSlot);
+			for (const Edge& slotEdge : m_graph[slot + 1])
+			{
+				if (slotEdge.to < getActivityIn(0) || slotEdge.to >= getActivityOut(0) || slotEdge.capacity != 0)
+					continue;
+				int activity{ slotEdge.to - getActivityIn(0) };
+				for (const Edge& activityEdge : m_graph[getActivityOut(activity)])
+				{
+					if (activityEdge.to >= getStaffNode(0) && activityEdge.to < getSink() && activityEdge.capacity == 0)
+						triples.push_back({ slot, activity, activityEdge.to - getStaffNode(0), activityEdge.cost });
+				}
+			}
+		}
+		return triples;
+	}
+};
+
+//sets of triples which together leave a spot with nothing to fill it, learned from the spots the fills could not fill
+//each triple of a slot, activity and staff member is packed into one integer, called a literal
+//every nogood is indexed by two of its literals, its watches, which are moved off literals as they are committed
+//so a nogood only needs checking when one of its watches is about to be committed and its other watch already has been
+class NogoodStore
+{
+	//a set of literals which leave a given spot with nothing to fill it once all of them are committed
+	struct Nogood
+	{
+		int victim{}; //ID of the spot left with nothing to fill it
+		std::vector<std::uint64_t> literals{}; //the triples responsible, the first two are watched
+	};
+
+	std::vector<Nogood> m_nogoods{}; //every nogood learned
+	std::unordered_map<std::uint64_t, std::vector<int>> m_watches{}; //the indices of the nogoods watching each literal
+
+public:
+
+	static constexpr std::size_t maxLength{ 8 }; //longer nogoods are not recorded since they rarely match again and cost more to check
+
+	//packs the IDs of a slot, activity and staff member filling each other into a literal
+	static constexpr std::uint64_t getLiteral(const int slotID, const int activityID, const int staffID)
+	{
+		return (static_cast<std::uint64_t>(slotID) << 32) | (static_cast<std::uint64_t>(activityID) << 16) | static_cast<std::uint64_t>(staffID);
+	}
+
+	//gets the ID of the slot of a given literal
+	static constexpr int getSlotID(const std::uint64_t literal)
+	{
+		return static_cast<int>(literal >> 32);
+	}
+
+	//gets the ID of the activity of a given literal
+	static constexpr int getActivityID(const std::uint64_t literal)
+	{
+		return static_cast<int>((literal >> 16) & 0xFFFF);
+	}
+
+	//gets the ID of the staff member of a given literal
+	static constexpr int getStaffID(const std::uint64_t literal)
+	{
+		return static_cast<int>(literal & 0xFFFF);
+	}
+
+	//records that the given literals together leave the spot with a given ID with nothing to fill it
+	//its first two literals are watched, which is right for the next fill since fills start with nothing committed and never undo a commit
+	void add(const int victim, std::vector<std::uint64_t> literals)
+	{
+		std::sort(literals.begin(), literals.end());
+		literals.erase(std::unique(literals.begin(), literals.end()), literals.end());
+		if (literals.empty() || literals.size() > maxLength)
+			return;
+
+		int index{ static_cast<int>(m_nogoods.size()) };
+		for (std::size_t watch{ 0 }; watch < std::min<std::size_t>(2, literals.size()); ++watch)
+			m_watches[literals[watch]].push_back(index);
+		m_nogoods.push_back({ victim, std::move(literals) });
+	}
+
+	//moves the watches of the nogoods watching a literal which has just been committed onto literals which have not been
+	//a nogood keeps its watch when every other literal is committed, since its other watch is then the only one left
+	template <typename IsCommitted>
+	void commit(const std::uint64_t literal, IsCommitted isCommitted)
+	{
+		auto found{ m_watches.find(literal) };
+		if (found == m_watches.end())
+			return;
+
+		std::vector<int> watching{ std::move(found->second) };
+		std::vector<int> kept{};
+		for (int index : watching)
+		{
+			std::vector<std::uint64_t>& literals{ m_nogoods[index].literals };
+			if (literals.size() < 2)
+			{
+				kept.push_back(index);
+				continue;
+			}
+			if (literals[0] == literal) //keeps the committed watch second so the first is the other watch
+				std::swap(literals[0], literals[1]);
+
+			std::size_t next{ 2 };
+			while (next < literals.size() && isCommitted(literals[next]))
+				++next;
+			if (next == literals.size())
+			{
+				kept.push_back(index);
+				continue;
+			}
+			std::swap(literals[1], literals[next]);
+			m_watches[literals[1]].push_back(index);
 		}
+		m_watches[literal] = std::move(kept); //looked up again since adding watches can rehash the index
+	}
+
+	//returns whether committing a given literal would complete a nogood whose spot has not been filled
+	//since watches are moved off committed literals, a nogood is complete when its other watch has been committed
+	template <typename IsCommitted, typename IsFilled>
+	bool forbids(const std::uint64_t literal, IsCommitted isCommitted, IsFilled isFilled) const
+	{
+		auto found{ m_watches.find(literal) };
+		if (found == m_watches.end())
+			return false;
+
+		for (int index : found->second)
+		{
+			const Nogood& nogood{ m_nogoods[index] };
+			if (isFilled(nogood.victim))
+				continue;
+			if (nogood.literals.size() == 1 || isCommitted(nogood.literals[nogood.literals[0] == literal ? 1 : 0]))
+				return true;
+		}
+		return false;
+	}
+
+	//removes the nogoods added since the store held a given number of them, so nogoods added for one fill can be taken away after it
+	//the watches of the nogoods kept may have moved, which does not matter since every fill starts with nothing committed
+	void truncate(const std::size_t size)
+	{
+		for (std::size_t index{ size }; index < m_nogoods.size(); ++index)
+		{
+			for (std::uint64_t literal : m_nogoods[index].literals) //the watches can have moved onto any of the literals
+			{
+				auto found{ m_watches.find(literal) };
+				if (found != m_watches.end())
+					std::erase_if(found->second, [size](const int watching) { return watching >= static_cast<int>(size); });
+			}
+		}
+		if (size < m_nogoods.size())
+			m_nogoods.resize(size);
+	}
+
+	//gets the number of nogoods learned
+	std::size_t size() const
+	{
+		return m_nogoods.size();
+	}
+};
+
+class FillSpot
+{
+
+	//prevents typos from causes bugs
+	enum sortDirection //possible sort directions of update sort
+	{
+		either,
+		decreased
+	};
+
+	std::vector < SpotWrapper*> m_spotsToBeFilled; //Holds all the activities and schedule slots to be filled
+	std::vector <Activity> m_activities; //Holds activities and ensures their existence for the lifetime of the class
+	std::vector <ScheduleSlot> m_scheduleSlots; //Holds schedule slots and ensures their existence for the lifetime of the class
+	std::vector <Staff> m_staff; //Holds staff and ensures their existence for the lifetime of the class
+	SpotTable m_spots; //looks up the spots above by the IDs the spots keep of each other
+
+	const SymmetryClasses& m_classes; //interchangeable activities and staff, only one spot of each class is tried for the same spot
+	NogoodStore& m_nogoods; //triples which left a spot with nothing to fill it, learned by this and earlier fills of the same roster
+	std::vector<SpotWrapper*> m_triedSpots{}; //the spots already tried as the second spot for the spot being filled
+	std::array<int, daysInCycle * periodsInDay> m_freeStaffAt{}; //the number of staff who can lead a slot of this fill at each time and are on no team then
+	std::vector<Staff*> m_assistants{}; //the staff found to help lead the triple being filled
+	std::vector<int> m_fillOrder{}; //IDs of the slots this fill has filled, in the order they were filled
+
+	//returns whether the spot at the given index of the spots to be filled array is available within a given spot
+	//throws std::out_of_range once the index passes the end of the list
+	bool foundIndex(SpotWrapper* spot, int index)
+	{
+		SpotWrapper* found{ m_spotsToBeFilled.at(index) };
+		if (found->getType() == SpotWrapper::Type::ScheduleSlot) //slots are looked up in the slot mask rather than searched for
+			return spot->m_slotMask.test(found->getID());
+		return spot->getAvailableSpots().contains(SpotId<SpotWrapper>{ found->getID() });
+	}
+
+	//returns whether two spots of the same class are in the same state, so trying one after the other would repeat the same search
+	//the lists of equivalent spots diverge once they fill different slots, so the live spots themselves are compared rather than how many there are
+	static bool isInSameState(SpotWrapper* spot1, SpotWrapper* spot2)
+	{
+		if (spot1->m_timesLeftPerCycle != spot2->m_timesLeftPerCycle || spot1->getAvailableSpots().size() != spot2->getAvailableSpots().size() || !(spot1->m_slotMask == spot2->m_slotMask))
+			return false;
+		if (spot1->getType() == SpotWrapper::Type::Staff && !static_cast<Staff*>(spot1)->hasSameWorkload(*static_cast<Staff*>(spot2)))
+			return false;
+		for (SpotId<SpotWrapper> available : spot1->getAvailableSpots())
+		{
+			if (!spot2->getAvailableSpots().contains(available))
+				return false;
+		}
+		return true;
+	}
+
+	//returns whether a spot would repeat a spot already tried, since it is in the same class and in the same state
+	bool isSymmetricToTried(SpotWrapper* spot)
+	{
+		for (SpotWrapper* tried : m_triedSpots)
+		{
+			if (m_classes.areEquivalent(spot, tried) && isInSameState(spot, tried))
+				return true;
+		}
+		return false;
+	}
+
+	std::size_t m_nextIndex{ 0 };
+
+	//gets the spot with the lowest index belonging to a given spot, skipping spots equivalent to ones already tried
+	SpotWrapper* getNext(SpotWrapper* spot)
+	{
+		if (m_nextIndex != 0)
+			++m_nextIndex;
+		try
+		{
+			while (!foundIndex(spot, m_nextIndex) || isSymmetricToTried(m_spotsToBeFilled[m_nextIndex]))
+				++m_nextIndex;
+		}
+		catch (...)
+		{
+			throw "Nothing can fill this spot";
+		}
+		m_triedSpots.push_back(m_spotsToBeFilled[m_nextIndex]);
+		return m_spotsToBeFilled[m_nextIndex];
+	}
+
+	//gets the spot with the lowest index belonging to the union of two given spots
+	SpotWrapper* getFirst(SpotWrapper* spot1, SpotWrapper* spot2)
+	{
+		//the third spot of an activity and a staff member must be a slot, so there is none when their slot masks have nothing in common
+		if (spot1->getType() != SpotWrapper::Type::ScheduleSlot && spot2->getType() != SpotWrapper::Type::ScheduleSlot && !spot1->m_slotMask.intersects(spot2->m_slotMask))
+			return nullptr;
+
+		std::size_t index{ 0 };
+		try
+		{
+			while (!foundIndex(spot1, index) || !foundIndex(spot2, index))
+				++index;
+		}
+		catch (...)
+		{
+			return nullptr;
+		}
+		return m_spotsToBeFilled[index];
+	}
+
+	std::vector<SpotWrapper*> m_sortBuffer{}; //scratch list the radix sort moves spots through, kept so it is not reallocated every sort
+
+	//sorts the spots to be filled by their sort keys with a least significant digit radix sort of 8 bit digits
+	//digits which are the same in every key (most of them, since ids and counts are small) are skipped
+	void radixSortSpotsToBeFilled()
+	{
+		std::uint64_t allOnes{ ~0ull }; //bits set in every key
+		std::uint64_t anyOnes{ 0 }; //bits set in any key
+		for (SpotWrapper* spot : m_spotsToBeFilled)
+		{
+			allOnes &= spot->m_sortKey;
+			anyOnes |= spot->m_sortKey;
+		}
+		const std::uint64_t differingBits{ allOnes ^ anyOnes };
+
+		m_sortBuffer.resize(m_spotsToBeFilled.size());
+		for (int shift{ 0 }; shift < 64; shift += 8)
+		{
+			if (((differingBits >> shift) & 0xFF) == 0)
+				continue;
+
+			//counts each digit, then turns the counts into the position each digit starts at
+			std::array<std::size_t, 257> starts{};
+			for (SpotWrapper* spot : m_spotsToBeFilled)
+				++starts[((spot->m_sortKey >> shift) & 0xFF) + 1];
+			for (std::size_t digit{ 1 }; digit < starts.size(); ++digit)
+				starts[digit] += starts[digit - 1];
+
+			//stable placement keeps the order of the less significant digits already sorted
+			for (SpotWrapper* spot : m_spotsToBeFilled)
+				m_sortBuffer[starts[(spot->m_sortKey >> shift) & 0xFF]++] = spot;
+			m_spotsToBeFilled.swap(m_sortBuffer);
+		}
+	}
+
+	//updates the spots to be filled list and its members indices
+	void updateSpotsToBeFilled()
+	{
+		//sorts by how soon the slot should be filled, the keys end in the spot's id so the order is reproducible
+		radixSortSpotsToBeFilled();
+
+		std::size_t endOfCompleted{ 0 };
+
+		//removes already filled spots from list, which the sort keys place at the front
+		while (endOfCompleted < m_spotsToBeFilled.size() && m_spotsToBeFilled[endOfCompleted]->getCompleted())
+			++endOfCompleted;
+		m_spotsToBeFilled.erase(m_spotsToBeFilled.begin(), m_spotsToBeFilled.begin() + endOfCompleted);
+
+		//updates the index of each spot to be filled
+		for (std::size_t index{ 0 }; index < m_spotsToBeFilled.size(); ++index)
+			m_spotsToBeFilled[index]->setIndex(index);
+	}
+
+	//fills the given slots, which all occur at the same time, with the cheapest matching of slots, activities and staff filling as many of them as possible
+	//a triple whose slot's participants need more staff than are free is ruled out and the slots left are matched again, so each pass fills a slot or rules out a triple
+	//returns the number of slots which could not be filled
+	int fillTime(TimePeriodMatcher& matcher, std::vector<ScheduleSlot*>& slots, std::vector<int>& matchIndex)
+	{
+		//the slots with the most participants are filled first, since they need the largest teams
+		std::stable_sort(slots.begin(), slots.end(), [](ScheduleSlot* slot1, ScheduleSlot* slot2)
+			{
+				return slot1->getNumberOfParticipants() > slot2->getNumberOfParticipants();
+			});
+
+		std::vector<ScheduleSlot*> left{ slots }; //the slots not filled yet
+		std::vector<std::pair<int, int>> ruledOut{}; //IDs of the slots and activities whose teams could not be found
+		while (!left.empty())
+		{
+			std::vector<Activity*> activities{}; //activities which can fill a slot at this time
+			std::vector<Staff*> staff{}; //staff who can fill a slot at this time
+
+			//gathers the activities and staff available to any of the slots, each once
+			for (ScheduleSlot* slot : left)
+			{
+				for (ActivityId activityID : slot->getActivitiesAvailable())
+				{
+					Activity* activity{ m_spots.get(activityID) };
+					if (matchIndex[activity->getID()] == -1 && !activity->getCompleted())
+					{
+						matchIndex[activity->getID()] = static_cast<int>(activities.size());
+						activities.push_back(activity);
+					}
+				}
+				for (StaffId memberID : slot->getStaffAvailable())
+				{
+					Staff* member{ m_spots.get(memberID) };
+					if (matchIndex[member->getID()] == -1 && !member->getCompleted())
+					{
+						matchIndex[member->getID()] = static_cast<int>(staff.size());
+						staff.push_back(member);
+					}
+				}
+			}
+
+			//an activity with fewer times left costs more, so activities are used up evenly and later times still have activities to choose between
+			//the preference costs are weighted above the sum of these costs over every slot at a time, so staff preferences still come first
+			constexpr int maximumTimesCost{ 63 };
+			constexpr int preferenceWeight{ (maximumTimesCost + 1) * static_cast<int>(Level::maxLevel) };
+			matcher.reset(static_cast<int>(left.size()), static_cast<int>(activities.size()), static_cast<int>(staff.size()));
+			for (std::size_t activityIndex{ 0 }; activityIndex < activities.size(); ++activityIndex)
+				matcher.addActivity(static_cast<int>(activityIndex), maximumTimesCost - std::clamp(activities[activityIndex]->m_timesLeftPerCycle, 0, maximumTimesCost));
+			for (std::size_t slotIndex{ 0 }; slotIndex < left.size(); ++slotIndex)
+			{
+				for (ActivityId activityID : left[slotIndex]->getActivitiesAvailable())
+				{
+					int activityIndex{ matchIndex[activityID.get()] };
+					if (activityIndex != -1 && activities[activityIndex]->getID() == activityID.get()
+						&& std::find(ruledOut.begin(), ruledOut.end(), std::pair<int, int>{ left[slotIndex]->getID(), activityID.get() }) == ruledOut.end())
+						matcher.addSlotActivity(static_cast<int>(slotIndex), activityIndex);
+				}
+			}
+
+			//preferred staff cost nothing, neutral staff cost 1 and unpreferred staff cost 2
+			for (std::size_t activityIndex{ 0 }; activityIndex < activities.size(); ++activityIndex)
+			{
+				int cost{ 0 };
+				for (SpotList<Staff>* leaders : { &activities[activityIndex]->getPreferredStaff(), &activities[activityIndex]->getNeutralStaff(), &activities[activityIndex]->getUnpreferredStaff() })
+				{
+					for (StaffId leader : *leaders)
+					{
+						int staffIndex{ matchIndex[leader.get()] };
+						if (staffIndex != -1 && staff[staffIndex]->getID() == leader.get())
+							matcher.addPair(static_cast<int>(activityIndex), staffIndex, cost * preferenceWeight);
+					}
+					++cost;
+				}
+			}
+			std::vector<MatchedTriple> triples{ matcher.match(static_cast<int>(left.size())) };
+
+			for (Activity* activity : activities)
+				matchIndex[activity->getID()] = -1;
+			for (Staff* member : staff)
+				matchIndex[member->getID()] = -1;
+
+			if (triples.empty()) //nothing can fill the slots left
+				break;
+
+			//the triples are in the order of their slots, so the slots with the most participants find their teams first
+			std::vector<bool> filled(left.size(), false);
+			for (const MatchedTriple& triple : triples)
+			{
+				ScheduleSlot* slot{ left[triple.slot] };
+				Activity* activity{ activities[triple.activity] };
+				Staff* member{ staff[triple.staff] };
+				if (!slot->getStaffAvailable().contains(getSpotId(*member)) || !findTeam(slot, activity, member))
+				{
+					ruledOut.push_back({ slot->getID(), activity->getID() });
+					continue;
+				}
+
+				//adds the three spots to each other the same way fillNextSpot does
+				markTeamBusy(slot, member);
+				slot->add(activity, member, m_spots);
+				activity->add(slot, member, m_spots);
+				member->add(slot, activity, m_spots);
+				commit(slot, activity, member);
+				addAssistants(slot);
+				m_fillOrder.push_back(slot->getID());
+				filled[triple.slot] = true;
+			}
+
+			std::size_t kept{ 0 };
+			for (std::size_t slotIndex{ 0 }; slotIndex < left.size(); ++slotIndex)
+			{
+				if (!filled[slotIndex])
+					left[kept++] = left[slotIndex];
+			}
+			left.resize(kept);
+		}
+		return static_cast<int>(left.size());
+	}
+
+	//removes a given spot from this fill's slots at a given time, found by their IDs, the same way filling a slot at that time would
+	//the slots are only removed from the spot's lists too when it is a staff member
+	void removeFromSlotsAt(SpotWrapper& spot, const int time)
+	{
+		for (int level{ 0 }; level < static_cast<int>(Level::maxLevel); ++level)
+		{
+			ScheduleSlot* slot{ m_spots.get(SlotId{ getSlotID(level, time) }) };
+			if (slot == nullptr || !spot.m_slotMask.test(slot->getID()))
+				continue;
+			slot->remove(&spot);
+			if (spot.getType() == SpotWrapper::Type::Staff)
+				spot.remove(slot);
+		}
+	}
+
+	//sorts three spots filling each other, given in any order, into their slot, activity and staff member
+	static std::tuple<ScheduleSlot*, Activity*, Staff*> getTriple(SpotWrapper* spot1, SpotWrapper* spot2, SpotWrapper* spot3)
+	{
+		std::tuple<ScheduleSlot*, Activity*, Staff*> triple{};
+		for (SpotWrapper* spot : { spot1, spot2, spot3 })
+		{
+			switch (spot->getType())
+			{
+			case SpotWrapper::Type::ScheduleSlot:
+				std::get<ScheduleSlot*>(triple) = static_cast<ScheduleSlot*>(spot);
+				break;
+			case SpotWrapper::Type::Activity:
+				std::get<Activity*>(triple) = static_cast<Activity*>(spot);
+				break;
+			default:
+				std::get<Staff*>(triple) = static_cast<Staff*>(spot);
+			}
+		}
+		return triple;
+	}
+
+	//gets the literal of the triple of three spots filling each other, given in any order
+	static std::uint64_t getLiteral(SpotWrapper* spot1, SpotWrapper* spot2, SpotWrapper* spot3)
+	{
+		auto [slot, activity, member] { getTriple(spot1, spot2, spot3) };
+		return NogoodStore::getLiteral(slot->getID(), activity->getID(), member->getID());
+	}
+
+	//counts a staff member as on a team at a given time, unless they could not lead any slot of this fill then and so were never counted as free
+	//must be called before their slots at the time are removed
+	void markBusy(const Staff& member, const int time)
+	{
+		for (int level{ 0 }; level < static_cast<int>(Level::maxLevel); ++level)
+		{
+			if (member.m_slotMask.test(getSlotID(level, time)))
+			{
+				--m_freeStaffAt[time];
+				return;
+			}
+		}
+	}
+
+	//finds the staff to help a given lead run a triple's activity in its slot, given in any order, and keeps them as the assistants
+	//staff who prefer the activity are asked first, returns whether enough staff were found for the slot's participants
+	//the number of staff free at the slot's time is checked first, so a slot there are too few staff for is ruled out in constant time
+	bool findTeam(SpotWrapper* spot1, SpotWrapper* spot2, SpotWrapper* spot3)
+	{
+		auto [slot, activity, lead] { getTriple(spot1, spot2, spot3) };
+		m_assistants.clear();
+		int needed{ activity->getStaffNeeded(slot->getNumberOfParticipants()) - 1 }; //the lead is already on the team
+		if (needed <= 0)
+			return true;
+		if (m_freeStaffAt[slot->getTime()] - 1 < needed)
+			return false;
+
+		SpotList<Staff>& slotStaff{ slot->getStaffAvailable() };
+		for (SpotList<Staff>* leaders : { &activity->getPreferredStaff(), &activity->getNeutralStaff(), &activity->getUnpreferredStaff() })
+		{
+			for (StaffId memberID : *leaders)
+			{
+				Staff* member{ m_spots.get(memberID) };
+				if (member == nullptr || member == lead || member->getCompleted() || !slotStaff.contains(memberID))
+					continue;
+				m_assistants.push_back(member);
+				if (static_cast<int>(m_assistants.size()) == needed)
+					return true;
+			}
+		}
+		return false;
+	}
+
+	//counts the lead and assistants of a slot's team as busy at its time, before the triple filling it is added
+	void markTeamBusy(ScheduleSlot* slot, Staff* lead)
+	{
+		markBusy(*lead, slot->getTime());
+		for (Staff* member : m_assistants)
+			markBusy(*member, slot->getTime());
+	}
+
+	//adds the assistants found for a slot to its team once its triple has been added
+	//this counts the slot towards their workload limits and keeps them from the other slots at its time the same way it does for the lead
+	void addAssistants(ScheduleSlot* slot)
+	{
+		for (Staff* member : m_assistants)
+		{
+			slot->m_staff.push_back(getSpotId(*member));
+			member->add(slot, m_spots);
+		}
+		m_assistants.clear();
+	}
+
+	//returns whether the triple of a given literal fills one of this fill's slots
+	bool isCommitted(const std::uint64_t literal)
+	{
+		ScheduleSlot* slot{ m_spots.get(SlotId{ NogoodStore::getSlotID(literal) }) };
+		return slot != nullptr && !slot->m_activities.empty() && !slot->m_staff.empty()
+			&& slot->m_activities[0].get() == NogoodStore::getActivityID(literal) && slot->m_staff[0].get() == NogoodStore::getStaffID(literal);
+	}
+
+	//returns whether committing the triple of a given literal would leave a spot which is still to be filled with nothing to fill it
+	bool isForbidden(const std::uint64_t literal)
+	{
+		return m_nogoods.forbids(literal, [this](const std::uint64_t other) { return isCommitted(other); }, [this](const int victim)
+			{
+				SpotWrapper* spot{ m_spots.get(SpotId<SpotWrapper>{ victim }) };
+				return spot == nullptr || spot->getCompleted();
+			});
+	}
+
+	//tells the nogoods that the triple of three spots has been committed so they can move their watches
+	void commit(SpotWrapper* spot1, SpotWrapper* spot2, SpotWrapper* spot3)
+	{
+		m_nogoods.commit(getLiteral(spot1, spot2, spot3), [this](const std::uint64_t other) { return isCommitted(other); });
+	}
+
+	//gets the literal of the triple filling a given slot
+	static std::uint64_t getFilledLiteral(const ScheduleSlot& slot)
+	{
+		return NogoodStore::getLiteral(slot.getID(), slot.m_activities[0].get(), slot.m_staff[0].get());
+	}
+
+	//adds the literals of the triples filling a given spot's slots to an explanation, only those at a given time unless it is -1
+	void explainBySlots(SpotWrapper& spot, std::vector<std::uint64_t>& explanation, const int time = -1)
+	{
+		for (SlotId slotID : spot.m_slots)
+		{
+			ScheduleSlot* slot{ m_spots.get(slotID) };
+			if (slot != nullptr && (time == -1 || slot->getTime() == time))
+				explanation.push_back(getFilledLiteral(*slot));
+		}
+	}
+
+	//explains why a spot nothing can fill lost each option it has lost with the triples responsible, and records them as a nogood
+	//an option is lost when it is filled or used up, when it or the spot is used at the same time, or by a staff member's workload limits
+	//nothing is recorded when a loss has no triple to explain it (e.g. a spot given up on) or the explanation is too long to check cheaply
+	void learnNogood(SpotWrapper* unfillable)
+	{
+		std::vector<std::uint64_t> explanation{};
+		bool isSlot{ unfillable->getType() == SpotWrapper::Type::ScheduleSlot };
+		for (SpotId<SpotWrapper> lostID : unfillable->getAvailableSpots().getRemoved())
+		{
+			SpotWrapper* lost{ m_spots.get(lostID) };
+			if (lost == nullptr) //the option was pruned since it is outside this fill
+				continue;
+
+			std::size_t explained{ explanation.size() };
+			if (lost->getCompleted())
+			{
+				if (lost->m_timesLeftPerCycle != 0) //given up on rather than filled
+					return;
+				if (lost->getType() == SpotWrapper::Type::ScheduleSlot)
+					explanation.push_back(getFilledLiteral(*static_cast<ScheduleSlot*>(lost)));
+				else
+					explainBySlots(*lost, explanation);
+			}
+			else if (isSlot || lost->getType() == SpotWrapper::Type::ScheduleSlot)
+			{
+				//the activity or staff member of the pair is used at the slot's time, or is a staff member at their limits
+				SpotWrapper& member{ isSlot ? *lost : *unfillable };
+				int time{ static_cast<ScheduleSlot*>(isSlot ? unfillable : lost)->getTime() };
+				explainBySlots(member, explanation, time);
+				if (explanation.size() == explained && member.getType() == SpotWrapper::Type::Staff)
+					explainBySlots(member, explanation);
+			}
+
+			if (explanation.size() == explained || explanation.size() > NogoodStore::maxLength)
+				return;
+		}
+		m_nogoods.add(unfillable->getID(), std::move(explanation));
+	}
+
+public:
+
+	//initializes the fillspot list of schedule slots, activities and staff. Sorts by how soon the slot should be filled and assigns the respective index in that list to each spot
+	FillSpot(std::vector < Activity>& activities, std::vector < ScheduleSlot>& scheduleSlots, std::vector < Staff>& staff, const SymmetryClasses& classes, NogoodStore& nogoods)
+		:m_activities{ std::move(activities) },//uses std::move for efficiency
+		m_scheduleSlots{ std::move(scheduleSlots) }, //uses std::move for efficiency
+		m_staff{ std::move(staff) },
+		m_spots{ m_scheduleSlots, m_activities, m_staff },
+		m_classes{ classes },
+		m_nogoods{ nogoods }
+	{
+
+		for (Activity& activity : m_activities) //adds pointers to all activities to spotsToBeFilled
+		{
+			m_spotsToBeFilled.push_back(&activity);
+		}
+
+		for (ScheduleSlot& scheduleSlot : m_scheduleSlots) //adds pointers to all scheduleSlots to spotsToBeFilled
+		{
+			m_spotsToBeFilled.push_back(&scheduleSlot);
+		}
+
+		for (Staff& staff : m_staff) //adds pointers to all scheduleSlots to spotsToBeFilled
+		{
+			m_spotsToBeFilled.push_back(&staff);
+		}
+
+		//the lists were copied and pruned before getting here, so every sort key is recalculated once
+		for (SpotWrapper* spot : m_spotsToBeFilled)
+			spot->updateSortKey();
+
+		//counts the staff who can lead a slot of this fill at each time, which bounds the teams at that time
+		for (Staff& member : m_staff)
+		{
+			std::bitset<daysInCycle * periodsInDay> times{};
+			member.m_slotMask.forEach([&times](const int slotID)
+				{
+					times.set(getSlotTime(slotID));
+				});
+			for (int time{ 0 }; time < daysInCycle * periodsInDay; ++time)
+				m_freeStaffAt[time] += times[time];
+		}
+
+		updateSpotsToBeFilled(); //updates the spots to be filled list and its members indices
+
+	}
+
+	//fills the next spot in the lsit and updates all spots as needed
+	//triples which complete a nogood are only used when nothing else can fill the spot, and a spot nothing can fill teaches a new nogood
+	//a triple is only used when enough other staff are free to make up the team its slot's participants need
+	SpotWrapper* fillNextSpot()
+	{
+
+		SpotWrapper* item1{ m_spotsToBeFilled[0] }; //gets the first spot as the first spot in the spots to be filled list
+		m_nextIndex = 0; //searches for the second spot from the start of the list
+		m_triedSpots.clear();
+
+		SpotWrapper* item2{ nullptr };
+
+
+
+
+		SpotWrapper* item3{ nullptr };
+		std::optional<std::pair<SpotWrapper*, SpotWrapper*>> forbidden{}; //the first second and third spot ruled out by a nogood
+
+		//gets the third spot as the first spot from the union of the first and second spot
+		while (item3 == nullptr) //while there is no common item bwtween item 1 and 2
+		{
+
+			try
+			{
+				item2 = getNext(item1); //gets the second spot as the first spot's next spot
+			}
+			catch (...)
+			{
+				if (forbidden) //a triple which leaves another spot unfillable is better than leaving this one unfilled
+				{
+					std::tie(item2, item3) = *forbidden;
+					break;
+				}
+				learnNogood(item1);
+				return item1; //if nothing can fill the spots return the first spot
+			}
+			//gets the third spot as the first spot from the union of the first and second spot
+			item3 = getFirst(item1, item2);
+			if (item3 != nullptr && !findTeam(item1, item2, item3))
+				item3 = nullptr;
+			else if (item3 != nullptr && isForbidden(getLiteral(item1, item2, item3)))
+			{
+				if (!forbidden)
+					forbidden = { item2, item3 };
+				item3 = nullptr;
+			}
+		}
+		if (forbidden && item2 == forbidden->first && item3 == forbidden->second)
+			findTeam(item1, item2, item3); //finds the forbidden triple's team again, since later triples replaced it
+
+		auto [slot, activity, lead] { getTriple(item1, item2, item3) };
+		markTeamBusy(slot, lead);
+		item1->add(item2, item3, m_spots); //adds the second and third spot to the first one and removes the first spot from the possible lists of the second and third spots if necessary
+		item2->add(item1, item3, m_spots); //adds the first and third spot to the second one and removes the second spot from the possible lists of the first and third spots if necessary
+		item3->add(item1, item2, m_spots); //adds the first and second spot to the third one and removes the third spot from the possible lists of the first and second spots if necessary
+		commit(item1, item2, item3);
+		addAssistants(slot);
+		m_fillOrder.push_back(slot->getID());
+
+		updateSpotsToBeFilled(); //updates the spots to be filled list and its members indices
+
+		return nullptr;
+	}
+
+	//counts the slots filled outside this fill, in earlier participant groups or the kept part of a schedule being repaired
+	//every staff member of their teams counts them towards their workload limits and activities can no longer fill this fill's slots at the same times
+	void addEarlierAssignments(const Schedule& schedule)
+	{
+		for (std::size_t slotID{ 0 }; slotID < schedule.staffIDs.size(); ++slotID)
+		{
+			if (!schedule.isFilled(static_cast<int>(slotID)) || m_spots.get(SlotId{ static_cast<int>(slotID) }) != nullptr)
+				continue;
+			int time{ getSlotTime(static_cast<int>(slotID)) };
+			schedule.forEachStaff(static_cast<int>(slotID), [this, time](const int staffID)
+				{
+					Staff* member{ m_spots.get(StaffId{ staffID }) };
+					if (member == nullptr)
+						return;
+					markBusy(*member, time);
+					removeFromSlotsAt(*member, time); //addWorkload leaves the slots at the same time to SpotWrapper::record, which only runs for this fill's slots
+					member->addWorkload(time, m_spots);
+				});
+			Activity* activity{ m_spots.get(ActivityId{ schedule.activityIDs[slotID] }) };
+			if (activity != nullptr)
+				removeFromSlotsAt(*activity, time);
+		}
+	}
+
+	//fills the slots of the given locked assignments before the search starts, returns how many were filled
+	//locked assignments whose slot is not part of this fill are skipped so the same list can be given to every participant group
+	//checkFeasibility has rejected locks which cannot be filled, so each fill must have given the locked activity and staff a time for every lock in its slots
+	int lockAssignments(const std::vector<LockedAssignment>& lockedAssignments)
+	{
+		int locked{ 0 }; //number of locked assignments filled
+
+		for (const LockedAssignment& lockedAssignment : lockedAssignments)
+		{
+			ScheduleSlot* slot{ m_spots.get(SlotId{ lockedAssignment.slotID }) };
+			if (slot == nullptr || slot->getCompleted()) //slot belongs to another fill or has already been locked
+				continue;
+
+			Activity* activity{ m_spots.get(ActivityId{ lockedAssignment.activityID }) };
+			Staff* staff{ m_spots.get(StaffId{ lockedAssignment.staffID }) };
+			if (activity == nullptr || staff == nullptr || activity->m_timesLeftPerCycle <= 0 || staff->m_timesLeftPerCycle <= 0)
+				throw "Locked assignment was given no times left to fill it\n";
+
+			//the locked activity and staff must still be able to fill the slot
+			SpotList<SpotWrapper>& available{ slot->getAvailableSpots() };
+			if (!available.contains(getSpotId(*activity)) || !available.contains(getSpotId(*staff)))
+				throw "Locked assignment is not available at its slot\n";
+
+			if (!findTeam(slot, activity, staff))
+				throw "Locked assignment cannot be given enough staff for its participants\n";
+
+			//adds the three spots to each other the same way fillNextSpot does
+			markTeamBusy(slot, staff);
+			slot->add(activity, staff, m_spots);
+			activity->add(slot, staff, m_spots);
+			staff->add(slot, activity, m_spots);
+			commit(slot, activity, staff);
+			addAssistants(slot);
+			m_fillOrder.push_back(slot->getID());
+			++locked;
+		}
+
+		if (locked != 0)
+			updateSpotsToBeFilled(); //completed spots are removed so the search only operates on the free part
+
+		return locked;
+	}
+
+	//fills every free slot one time period at a time, assigning all the slots at a time at once with the cheapest matching of activities and staff
+	//returns the number of slots which could not be filled
+	int fillByMatching(SolveBudget& budget)
+	{
+		constexpr int numberOfTimes{ daysInCycle * periodsInDay };
+		std::array<std::vector<ScheduleSlot*>, numberOfTimes> slotsAtTime{}; //the free slots at each time
+		for (ScheduleSlot& slot : m_scheduleSlots)
+		{
+			if (!slot.getCompleted())
+				slotsAtTime[slot.getTime()].push_back(&slot);
+		}
+
+		//matches the times with the fewest possible activities first since they have the least choice
+		std::vector<int> times{};
+		for (int time{ 0 }; time < numberOfTimes; ++time)
+		{
+			if (!slotsAtTime[time].empty())
+				times.push_back(time);
+		}
+		std::stable_sort(times.begin(), times.end(), [&slotsAtTime](const int time1, const int time2)
+			{
+				return slotsAtTime[time1][0]->getActivitiesAvailable().size() < slotsAtTime[time2][0]->getActivitiesAvailable().size();
+			});
+
+		int unfilled{ 0 };
+		TimePeriodMatcher matcher{}; //reused by every time so its network is only allocated once
+		std::vector<int> matchIndex(getNumberOfSpotIDs(m_activities, m_staff), -1); //the index of each activity and staff member in the matcher, by ID
+		for (int time : times)
+		{
+			if (!budget.step()) //leaves the remaining times unfilled once the budget is used up
+			{
+				unfilled += static_cast<int>(slotsAtTime[time].size());
+				continue;
+			}
+			int unfilledAtTime{ fillTime(matcher, slotsAtTime[time], matchIndex) };
+			budget.progress.slotsFilled += static_cast<int>(slotsAtTime[time].size()) - unfilledAtTime;
+			unfilled += unfilledAtTime;
+		}
+		return unfilled;
+	}
+
+	//stops trying to fill a given spot, it is marked completed so it leaves the spots to be filled
+	void abandon(SpotWrapper* spot)
+	{
+		spot->m_completed = true;
+		spot->updateSortKey();
+		updateSpotsToBeFilled();
+	}
+
+	//gives up on the spots with nothing left to fill, so they are never picked to fill another spot
+	void abandonEmptySpots()
+	{
+		for (SpotWrapper* spot : m_spotsToBeFilled)
+		{
+			if (spot->m_timesLeftPerCycle <= 0)
+			{
+				spot->m_completed = true;
+				spot->updateSortKey();
+			}
+		}
+		updateSpotsToBeFilled();
+	}
+
+	//gets whether any spot is still being filled
+	bool hasSpotsToFill() const
+	{
+		return !m_spotsToBeFilled.empty();
+	}
+
+	//fills spots until every slot of this fill is filled or nothing can fill it, returns the number of slots left unfilled
+	//a spot which cannot be filled is given up on rather than retried with other fill lists, so each spot is tried at most once
+	int fillRemaining(SolveBudget& budget)
+	{
+		abandonEmptySpots();
+
+		int slotsLeft{ static_cast<int>(std::count_if(m_scheduleSlots.begin(), m_scheduleSlots.end(), [](const ScheduleSlot& slot)
+			{
+				return !slot.getCompleted();
+			})) };
+		int unfilled{ 0 };
+		while (slotsLeft > 0 && !m_spotsToBeFilled.empty() && budget.step())
+		{
+			SpotWrapper* unfillable{ fillNextSpot() };
+			if (unfillable == nullptr)
+			{
+				--slotsLeft;
+				++budget.progress.slotsFilled;
+				continue;
+			}
+			if (unfillable->getType() == SpotWrapper::Type::ScheduleSlot)
+			{
+				--slotsLeft;
+				++unfilled;
+			}
+			abandon(unfillable);
+		}
+		return unfilled + slotsLeft;
+	}
+
+	//records the activity and team of staff filling each of this fill's slots in the given schedule, the lead is the first staff member added
+	//the slots are added to the end of the schedule's fill order in the order this fill decided them
+	void recordAssignments(Schedule& schedule)
+	{
+		for (ScheduleSlot& slot : m_scheduleSlots)
+		{
+			if (slot.m_activities.empty() || slot.m_staff.empty())
+				continue;
+			schedule.assign(slot.getID(), slot.m_activities[0].get(), slot.m_staff[0].get());
+			for (std::size_t index{ 1 }; index < slot.m_staff.size(); ++index)
+				schedule.addAssistant(slot.getID(), slot.m_staff[index].get());
+		}
+		schedule.fillOrder.insert(schedule.fillOrder.end(), m_fillOrder.begin(), m_fillOrder.end());
+	}
+
+	//adds 1 times to fill and times left to fill to the activity or staff member with given id, returns whether they could be added to
+	//a spot given up on because it had nothing to fill is filled again, a spot which was filled or could not be filled is not
+	bool addToSlot(int id)
+	{
+		SpotWrapper* found{ m_spots.get(SpotId<SpotWrapper>{ id }) };
+		if (found == nullptr || (found->getCompleted() && found->getTimesPerCycle() != 0))
+			return false;
+
+		//increments times to fill and times left to fill
+		found->incrementTimesPerCycle();
+		found->incrementTimesLeftPerCycle();
+		if (found->getCompleted())
+		{
+			found->m_completed = false;
+			m_spotsToBeFilled.push_back(found);
+		}
+		found->updateSortKey();
+		updateSpotsToBeFilled();
+		return true;
+	}
+};
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+//removes the slots not in a given set from a spot's lists, for a fill which only uses some of the slots
+//the lists hold IDs, which mean the same spot in every copy of the roster, so the rest of the lists are used as they were copied
+void pruneToSlots(SpotWrapper& spot, const SlotMask& slots)
+{
+	spot.m_slotMask = spot.m_slotMask & slots; //keeps only the slots used by the fill
+
+	//rebuilds the list from the mask
+	SpotList<ScheduleSlot>& possibleSlots{ spot.getTimesAvailable() };
+	possibleSlots.clear();
+	spot.m_slotMask.forEach([&possibleSlots](const int slotID)
+		{
+			possibleSlots.push_back(SlotId{ slotID });
+		});
+
+	//slots outside the fill are dropped from the available spots too, found first since removing a spot reorders the list
+	std::vector<SpotId<SpotWrapper>> outOfScope{};
+	for (SpotId<SpotWrapper> available : spot.getAvailableSpots())
+	{
+		if (available.get() < numberOfSlotIDs && !slots.test(available.get()))
+			outOfScope.push_back(available);
+	}
+	for (SpotId<SpotWrapper> available : outOfScope)
+		spot.getAvailableSpots().remove(available);
+	spot.updateSortKey();
+}
+
+class ParticipantGroup
+{
+	int m_participants{}; //holds number of participants in group
+	std::vector <ScheduleSlot> m_scheduleSlots{}; //holds scheduleSlots in group
+	std::vector <Activity> m_activities{}; //holds activities in group
+	std::vector <Staff> m_staff{}; //holds staff in group
+	int m_totalTimeSlots{};
+	std::size_t m_firstFillIndex{}; //holds the index of this group's first entry in the fill lists
+	int m_unfilledSlots{};
+	ScheduleSlot* m_startOfListPointer{}; //holds the first slot of this group in the sorted roster
+	SlotMask m_groupSlots{}; //holds the IDs of the slots in this group
+
+	//gets the end of this group's part of a fill list, which holds one entry for each of its slots
+	template <typename T>
+	std::size_t getEndOfFillList(const std::vector<SpotId<T>>& spotsToFill) const
+	{
+		return std::min(m_firstFillIndex + m_scheduleSlots.size(), spotsToFill.size());
+	}
+
+	//preforms prune actions on activity's possible slots
+	void pruneActivities(const std::vector <ActivityId>& activitiesToFill)
+	{
+		for (Activity& activity : m_activities) //for each activity
+		{
+			//resets times per cycle and times left per cycle
+			activity.setTimesPerCycle( 0 );
+			activity.setTimesLeftPerCycle( 0 );
+
+			pruneToSlots(activity, m_groupSlots);
+		}
+
+		//increment each copy of activity corresponding with this group's part of the list to fill to get proper spots to fill for each activity
+		for (std::size_t index{ m_firstFillIndex }; index < getEndOfFillList(activitiesToFill); ++index)
+		{
+			m_activities[activitiesToFill[index].get() - m_activities[0].getID()].incrementTimesPerCycle();
+			m_activities[activitiesToFill[index].get() - m_activities[0].getID()].incrementTimesLeftPerCycle();
+		}
+	}
+
+	//puts the activity and staff of each locked assignment in this group's slots at the start of this group's part of the fill lists
+	//the fill lists leave the locked times out, so only the group holding a locked slot is given its time and earlier groups cannot use it up
+	void addLockedTimes(std::vector <ActivityId>& activitiesToFill, std::vector <StaffId>& staffToFill, const std::vector<LockedAssignment>& lockedAssignments)
+	{
+		for (const LockedAssignment& lockedAssignment : lockedAssignments)
+		{
+			if (!m_groupSlots.test(lockedAssignment.slotID))
+				continue;
+			activitiesToFill.insert(activitiesToFill.begin() + static_cast<std::ptrdiff_t>(std::min(m_firstFillIndex, activitiesToFill.size())), ActivityId{ lockedAssignment.activityID });
+			staffToFill.insert(staffToFill.begin() + static_cast<std::ptrdiff_t>(std::min(m_firstFillIndex, staffToFill.size())), StaffId{ lockedAssignment.staffID });
+		}
+	}
+
+	//preforms prune actions on staff's possible slots
+	void pruneStaff(const std::vector <StaffId>& staffToFill)
+	{
+		for (Staff& staff : m_staff) //for each staff
+		{
+			//resets times per cycle and times left per cycle
+			staff.setTimesPerCycle( 0 );
+			staff.setTimesLeftPerCycle( 0 );
+
+			pruneToSlots(staff, m_groupSlots);
+		}
+		//increment each copy of staff corresponding with this group's part of the list to fill to get proper spots to fill for each activity
+		for (std::size_t index{ m_firstFillIndex }; index < getEndOfFillList(staffToFill); ++index)
+		{
+			m_staff[staffToFill[index].get() - m_staff[0].getID()].incrementTimesPerCycle();
+			m_staff[staffToFill[index].get() - m_staff[0].getID()].incrementTimesLeftPerCycle();
+		}
+	}
+
+	//replaces the times a spot could not be placed with the next entries of a fill list which no group has been given
+	//entries whose spot was filled or could not be filled are skipped, so once the list runs out the times are left unfilled
+	template <typename T>
+	void useNextInFillList(FillSpot& filler, const std::vector<SpotId<T>>& spotsToFill, std::size_t& next, int times)
+	{
+		while (times > 0 && next < spotsToFill.size())
+		{
+			if (filler.addToSlot(spotsToFill[next].get()))
+				--times;
+			++next;
+		}
+	}
+
+	//moves the entries of a fill list which this group placed to the front of its part of the list, in their order, so the next group starts after them
+	//the part of the list runs to the last entry this group used from beyond it
+	template <typename T>
+	void consumeFillList(std::vector<SpotId<T>>& spotsToFill, const std::size_t end, std::vector<int> placed, const int firstID)
+	{
+		std::vector<SpotId<T>> notPlaced{}; //the entries left for later groups, in their order
+		std::size_t write{ m_firstFillIndex };
+		for (std::size_t read{ m_firstFillIndex }; read < end; ++read)
+		{
+			int& times{ placed[static_cast<std::size_t>(spotsToFill[read].get() - firstID)] };
+			if (times > 0)
+			{
+				--times;
+				spotsToFill[write++] = spotsToFill[read];
+			}
+			else
+				notPlaced.push_back(spotsToFill[read]);
+		}
+		std::copy(notPlaced.begin(), notPlaced.end(), spotsToFill.begin() + static_cast<std::ptrdiff_t>(write));
+	}
+
+		//fills participant group
+		void fill(std::vector <ActivityId>& activitiesToFill, std::vector <StaffId>& staffToFill, const std::vector<LockedAssignment>& lockedAssignments, Schedule& schedule, const SolverOptions& options, const SymmetryClasses& classes, NogoodStore& nogoods, SolveBudget& budget)
+	{
+		int numberOfScheduleSlots{ static_cast<int>(m_scheduleSlots.size()) }; //holds number if schedule slots
+		std::size_t nextActivity{ getEndOfFillList(activitiesToFill) }; //the next entry of each fill list which no group has been given
+		std::size_t nextStaff{ getEndOfFillList(staffToFill) };
+		std::vector<int> activitiesPlaced(m_activities.size(), 0); //the times each activity and staff member is placed by this group
+		std::vector<int> staffPlaced(m_staff.size(), 0);
+		int firstActivityID{ m_activities.empty() ? 0 : m_activities[0].getID() };
+		int firstStaffID{ m_staff.empty() ? 0 : m_staff[0].getID() };
+
+		FillSpot filler(m_activities, m_scheduleSlots, m_staff, classes, nogoods); //initialize fillspot
+		int numberOfLockedSlots{ filler.lockAssignments(lockedAssignments) }; //fills locked slots first so only the free slots are searched
+		filler.addEarlierAssignments(schedule); //activities and staff cannot fill slots at the same time in two groups, and staff cannot lead beyond their limits over all groups
+		budget.progress.slotsFilled += numberOfLockedSlots;
+
+		if (options.matching) //fills each time period at once instead of one triple at a time
+			filler.fillByMatching(budget);
+		else
+		{
+			//fill each slot in list, giving up on each spot nothing can fill
+			//every pass fills a slot or gives up on a spot, and a spot given up on is only filled again if it had nothing to fill, so the loop ends without a budget
+			filler.abandonEmptySpots();
+			int slotsLeft{ numberOfScheduleSlots - numberOfLockedSlots };
+			while (slotsLeft > 0 && filler.hasSpotsToFill() && budget.step())
+			{
+				SpotWrapper* unfillable{ filler.fillNextSpot() };
+				if (unfillable == nullptr)
+				{
+					--slotsLeft;
+					++budget.progress.slotsFilled;
+					continue;
+				}
+
+				++budget.progress.retries;
+				int timesLeft{ unfillable->m_timesLeftPerCycle }; //the times the spot could not be placed
+				filler.abandon(unfillable);
+
+				//an activity or staff member is replaced by the next ones in the fill list which have not been tried
+				if (unfillable->getType() == SpotWrapper::Type::Activity)
+					useNextInFillList(filler, activitiesToFill, nextActivity, timesLeft);
+				else if (unfillable->getType() == SpotWrapper::Type::Staff)
+					useNextInFillList(filler, staffToFill, nextStaff, timesLeft);
+				//a slot is left for the next group to try
+				else
+					--slotsLeft;
+			}
+		}
+		filler.recordAssignments(schedule); //copies the filled slots out before the filler is destroyed
+
+		//counts what this group placed so the fill lists and the roster show where the next group starts, the filler has taken the group's own spots
+		m_groupSlots.forEach([&](const int slotID)
+			{
+				if (!schedule.isFilled(slotID))
+					return;
+				std::size_t activity{ static_cast<std::size_t>(schedule.activityIDs[slotID] - firstActivityID) };
+				std::size_t lead{ static_cast<std::size_t>(schedule.staffIDs[slotID] - firstStaffID) };
+				if (activity < activitiesPlaced.size())
+					++activitiesPlaced[activity];
+				if (lead < staffPlaced.size())
+					++staffPlaced[lead];
+			});
+		consumeFillList(activitiesToFill, nextActivity, std::move(activitiesPlaced), firstActivityID);
+		consumeFillList(staffToFill, nextStaff, std::move(staffPlaced), firstStaffID);
+
+		//moves the unfilled slots to the end of the block, where the next group starts, so they are tried again
+		ScheduleSlot* endOfList{ m_startOfListPointer + numberOfScheduleSlots };
+		ScheduleSlot* firstUnfilled{ std::stable_partition(m_startOfListPointer, endOfList, [&schedule](const ScheduleSlot& slot)
+			{
+				return schedule.isFilled(slot.getID());
+			}) };
+		m_unfilledSlots = static_cast<int>(endOfList - firstUnfilled);
+	}
+
+
+
+public:
+
+	ParticipantGroup() = default;
+
+	//use given pointers and lists to copy list of Schedule Slots, activities and staff and initialize member variables
+	ParticipantGroup(ScheduleSlot* startOfList, ScheduleSlot* endOfList, const std::vector<Activity>& activities, const std::vector<Staff>& staff, const int numberOfFilledSlots, std::vector<ActivityId>& activitiesToFill, std::vector<StaffId>& staffToFill, const std::vector<LockedAssignment>& lockedAssignments, Schedule& schedule, const SolverOptions& options, const SymmetryClasses& classes, NogoodStore& nogoods, SolveBudget& budget)
+		:m_activities{ activities },
+		m_staff{ staff },
+		m_firstFillIndex{ static_cast<std::size_t>(numberOfFilledSlots) },
+		m_startOfListPointer{ startOfList }
+	{
+		m_scheduleSlots.assign(startOfList, endOfList + 1); //gets copy so that we can fill spots using only slots in this group, the end of the list is inclusive
+		for (ScheduleSlot& slot : m_scheduleSlots)
+			m_groupSlots.set(slot.getID());
+		m_participants= m_scheduleSlots[0].getNumberOfParticipants();
+		m_totalTimeSlots=m_scheduleSlots.size();
+		addLockedTimes(activitiesToFill, staffToFill, lockedAssignments);
+		pruneActivities(activitiesToFill);
+		pruneStaff(staffToFill);
+		fill(activitiesToFill, staffToFill, lockedAssignments, schedule, options, classes, nogoods, budget);
+	}
+
+	//gets total time slots
+	constexpr int getTotalTimeSlots() const
+	{
+		return m_totalTimeSlots;
+	}
+
+
+
+	//prints out cyclical schedule
+	/*void printCycleSchedule()
+	{
+		for (std::size_t j{ 0 }; j < daysInCycle; ++j) //for each day in cycle
+		{
+			for (std::size_t i{ 0 }; i < periodsInDay; ++i) //for each period in day, print the schedule slot
+				std::cout << i + 1 << ". " << scheduleSlots[j * 10 + i].getActivity()->getName() << "\n";
+			std::cout << "---------------------------\n"; //divider between days
+		}
+	}*/
+
+	constexpr int getUnfilledSlots() const
+	{
+		return m_unfilledSlots;
+	}
+
+
+};
+
+
+
+//find next semicolon in given string
+std::size_t findNextSemi(std::string_view string)
+{
+	return string.find(':');
+}
+
+//find next comma in given string
+std::size_t findEnd(std::string_view string)
+{
+	return string.find(',');
+}
+
+template <typename T, typename U>
+void getScheduleSlots(std::string& line, std::vector<U>& fillVector, std::vector <T>& scheduleSlots, const bool oneRange, const int offset)
+{
+	std::size_t(*endpoint)(std::string_view)(&findNextSemi); //initializes endpoint function pointer and sets it to point to find next semi
+	bool loopAgain{ true }; //controls whether or not the loop will continue iterating
+	while (loopAgain)	//loops while more time available ranges exist (while dividers exist plus once more)
+	{
+		if (line.find(':') == std::string::npos)//if range divider does not exist, stop looping after this iteration and search for boundary to times per cycle instead of between ranges
+		{
+			loopAgain = false; //stop iterating (this is the last range)
+			endpoint = &findEnd; //set endpoint to comma (since that is the divider between csv columns)
+		}
+
+
+		std::size_t startRange{ static_cast<std::size_t>(std::stoi(line.substr(0, line.find('-')))) - 1 };//gets start of range
+		std::size_t endRange{ static_cast<std::size_t>(std::stoi(line.substr(line.find('-') + 1,endpoint(line)))) - 1 }; //gets end of range
+		for (std::size_t index{ startRange }; index <= endRange; ++index) //while within range update time available to true and iterate total times available
+		{
+			if (oneRange)
+				fillVector.push_back(&scheduleSlots[index + offset]); //adds a pointer to the scheduleSlots at the given time to the list of times it can occur at
+			else
+			{
+				for (std::size_t j{ index }; j < static_cast<int>(Level::maxLevel) * daysInCycle * periodsInDay; j += daysInCycle * periodsInDay)
+					fillVector.push_back(&scheduleSlots[j]);
+			}
+		}
+		line = line.substr(endpoint(line) + 1, line.size() - endpoint(line)); //remove range added from range list
+	}
+}
+
+template <typename T, typename U>
+void getScheduleSlots(std::string& line, std::vector<U>& fillVector, std::vector <T>& scheduleSlots)
+{
+	getScheduleSlots(line, fillVector, scheduleSlots, false, 0);
+}
+
+template <typename T>
+void getScheduleSlots(std::string& line, std::vector<T*>& fillVector, std::vector <T>& scheduleSlots, const int offset)
+{
+	getScheduleSlots(line, fillVector, scheduleSlots, true, offset);
+}
+void getStrings(std::string_view line, std::vector<std::string>& fillVector)
+{
+	std::size_t(*endpoint)(std::string_view)(&findNextSemi); //initializes endpoint function pointer and sets it to point to find next semi
+	bool loopAgain{ true }; //controls whether or not the loop will continue iterating
+	while (loopAgain)	//loops while more time available ranges exist (while dividers exist plus once more)
+	{
+		if (line.find(':') == std::string::npos)//if range divider does not exist, stop looping after this iteration and search for boundary to times per cycle instead of between ranges
+		{
+			loopAgain = false; //stop iterating (this is the last range)
+			endpoint = &findEnd; //set endpoint to comma (since that is the divider between csv columns)
+		}
+
+		fillVector.emplace_back(line.substr(0, endpoint(line))); //adds index to list of values in vector
+		line = line.substr(endpoint(line) + 1, line.size() - endpoint(line)); //remove range added from range list
+	}
+}
+
+//add activity category to categories vector
+//note: activities is non const since ActivityCategory intializer moves activity to its list of activities
+void createActivityCategory(std::vector <ActivityCategory>& categories, std::string_view category, std::vector<Activity>& activities)
+{
+	std::sort(activities.begin(), activities.end(), [](Activity first, Activity second) //sorts activity list by total times available
+		{
+			return first.getTimesAvailable().size() < second.getTimesAvailable().size();
+		});
+	categories.push_back(ActivityCategory(category, activities));
+}
+
+//takes in a list of activity names to search for and fills a list of pointers to those activities
+//note activities cannot be const since they are added to the activity list which may later be changed via their pointer
+void getActivities(const std::vector<std::string>& activityNames, std::vector<Activity*>& activityPointers, std::vector <Activity>& activities)
+{
+	for (std::size_t i{ 0 }; i < activityNames.size(); ++i) //loops through all activities we are searching for
+	{
+		bool loopAgain{ true }; //control variable that allows the process to skip to searching for next activity once the activity has been found
+		for (std::size_t k{ 0 }; k < activities.size() && loopAgain; ++k) //loops through activities while there are more to search and the activity has not yet been found
+		{
+
+			if (activities[k].getName() == activityNames[i]) //if the activity is the activity we are searching for (it has the same name as the next activity in the list of activities we are searching for)
+			{
+				activityPointers.push_back(&(activities[k])); //add a pointer to the activity to the activities vector
+				loopAgain = false; //marks activity as found, allowing process to skip to next activity
+			}
+		}
+	}
+}
+
+
+//takes in list of avilable times for a staff to elad at and adds a pointer to the roster's schedule slot of every level at each of those times to the scheduleSlotsAvailable list
+void getScheduleSlots(const std::vector<std::size_t>& avail, std::vector<ScheduleSlot*>& scheduleSlotsAvailable, std::vector<ScheduleSlot>& scheduleSlots)
+{
+	for (int level{ 0 }; level < static_cast<int>(Level::maxLevel); ++level)
+	{
+		for (std::size_t time : avail)
+			scheduleSlotsAvailable.push_back(&scheduleSlots[getSlotID(level, static_cast<int>(time))]);
+	}
+}
+
+//takes in a string and a breakpoint and fiils the inputted activity pointers vector with activity pointers to the activites found within the string
+void processActivitiesListFromFileToVectorofActivityPointers(std::string_view line, std::vector<Activity*>& activityPointers, std::vector <Activity>& activities, const std::size_t breakLocation)
+{
+	std::string raw{ line.substr(0,breakLocation) };  //hold raw list of activities
+	std::vector<std::string> names{}; //holds list of activities names
+	getStrings(raw, names); //processes raw list and fills list of activities names
+	getActivities(names, activityPointers, activities); //gets list of pointers to activities using their names and fills activity pointers vector
+}
+
+//reads in the optional number columns at the end of a row into the given values in order, columns which are missing or empty keep their default
+//a column which is not a whole number throws the given error, the way the readers report a bad row
+void readInOptionalColumns(std::string_view line, std::initializer_list<int*> values, const char* error)
+{
+	for (int* value : values)
+	{
+		if (line.empty())
+			break;
+		std::size_t comma{ line.find(',') };
+		std::string_view column{ line.substr(0, comma) };
+		if (!column.empty() && column.back() == '\r')
+			column.remove_suffix(1);
+		if (!column.empty())
+		{
+			auto [end, result] { std::from_chars(column.data(), column.data() + column.size(), *value) };
+			if (result != std::errc{} || end != column.data() + column.size())
+				throw error;
+		}
+		line = comma == std::string_view::npos ? std::string_view{} : line.substr(comma + 1);
+	}
+}
+
+//reads in staff from file and stores in the staff vector
+//note activities is non const due to getActivities
+void readInStaff(std::istream& myReader, std::vector <Activity>& activities, std::vector <Staff>& staff, std::vector <ScheduleSlot>& scheduleSlots, int& nextID)
+{
+	std::string line{};//holds line data
+	while (std::getline(myReader, line)) //iterates for each staff in the staff section
+	{
+		std::size_t breakLocation{ line.find(',') };//location of break between staff name and preferred lead activities
+		std::string name{ line.substr(0,breakLocation) }; //holds staff name
+
+		line = line.substr(breakLocation + 1, line.size()); //line removes staff name and break
+		std::vector<Activity*> preferred{}; //holds list of pointers to preffered activites
+		breakLocation = line.find(','); //location of next breakpoint (at the end of the list of preffered activites)
+		processActivitiesListFromFileToVectorofActivityPointers(line, preferred, activities, breakLocation); //fills preferred vector with pointer to activities between the previous and current breakpoints
+
+		line = line.substr(breakLocation + 1, line.size()); //line removes list of preferred names and break
+		std::vector<Activity*> neutral{}; //holds list of pointers to preffered activites
+		breakLocation = line.find(','); //location of next breakpoint (at the end of the list of neutral activites)
+		processActivitiesListFromFileToVectorofActivityPointers(line, neutral, activities, breakLocation); //fills neutral vector with pointer to activities between the previous and current breakpoints
+
+		line = line.substr(breakLocation + 1, line.size()); //line removes neutral names and break
+		std::vector<Activity*> unpreferred{}; //holds list of pointers to preffered activites
+		breakLocation = line.find(','); //location of next breakpoint (at the end of the list of unpreferred activites)
+		processActivitiesListFromFileToVectorofActivityPointers(line, unpreferred, activities, breakLocation); //fills unpreferred vector with pointer to activities between the previous and current breakpoints
+
+		line = line.substr(breakLocation + 1, line.size()); //line removes unpreferred names and break
+		breakLocation = line.find(','); //location of the break after the list of breaks, if workload limits follow them
+		StaffLimits limits{}; //the optional workload limit columns (minimum load, maximum load, daily cap, max consecutive periods)
+		readInOptionalColumns(breakLocation == std::string::npos ? std::string_view{} : std::string_view{ line }.substr(breakLocation + 1), { &limits.minimumLoad, &limits.maximumLoad, &limits.dailyCap, &limits.maxConsecutive }, "Invalid staff workload limits\n");
+		if (limits.minimumLoad < 0 || limits.minimumLoad > limits.maximumLoad || limits.dailyCap < 1 || limits.maxConsecutive < 1)
+			throw "Invalid staff workload limits\n";
+		std::vector<ScheduleSlot*> staffBreaks{}; //stores the level A slot at each of this staff member's break times
+		if (!line.empty() && line[0] != ',') //a staff member without breaks leaves the column empty
+			getScheduleSlots(line, staffBreaks, scheduleSlots, 0); //gets staff breaks from line, level A slots are numbered by their time
+		std::bitset<daysInCycle * periodsInDay> onBreak{}; //marks every time the staff member is on break
+		for (ScheduleSlot* slot : staffBreaks)
+			onBreak.set(static_cast<std::size_t>(slot->getTime()));
+		std::vector < std::size_t > availableTimes{}; //holds all the schedule slots where the staff can lead (not break times)
+		for (std::size_t i{ 0 }; i < periodsInDay * daysInCycle; ++i) //loops throough all possible schedule slots
+		{
+			if (!onBreak[i]) //if the schedule slot is not in the break list
+				availableTimes.push_back(i); //add the index of the schedule slot to the times available vector
+		}
+		std::vector<ScheduleSlot*> timesAvailable{}; //holds pointers to the schedule slots corresponding to the times the staff can lead at
+		getScheduleSlots(availableTimes, timesAvailable, scheduleSlots); //fills the list of pointers using the indecies of the times that the staff can lead at 
+
+		staff.emplace_back(name, limits, preferred, neutral, unpreferred, timesAvailable, nextID++); //adds staff member to staff vector
+
+	}
+}
+
+//reads in activitiy info from the activity rows, creates activity objects and stores them in activities vector
+void readInActivities(std::istream& myReader, std::vector <Activity>& activities, std::vector <ScheduleSlot>& scheduleSlots, int& nextID)
+{
+
+	std::string line{};//holds line data
+	while (std::getline(myReader, line)) //reads one activity at a time until the end of the activity section
+	{
+		std::size_t comma{ line.find(',') }; //find break between activity name and activity times available
+		std::string activityName{ line.substr(0,comma) }; //stores activity name
+		line = line.substr(comma + 1, line.size() - comma - 1); //removes activty name from line
+		std::vector < ScheduleSlot* > timesAvailable{};//array storing if activity is available at each time slot
+
+		getScheduleSlots(line, timesAvailable, scheduleSlots); //gets times available from line and adds it to times avaliable vector
+
+		int timesPerCycle{ std::stoi(line) }; //rest of line after times avaible is times per cycle
+		std::size_t ratioBreak{ line.find(',') }; //location of the break after times per cycle, if a staff ratio follows it
+		StaffRatio ratio{}; //the optional staff ratio columns (campers per staff member, minimum staff)
+		readInOptionalColumns(ratioBreak == std::string::npos ? std::string_view{} : std::string_view{ line }.substr(ratioBreak + 1), { &ratio.campersPerStaff, &ratio.minimumStaff }, "Invalid activity staff ratio\n");
+		if (ratio.campersPerStaff < 0 || ratio.minimumStaff < 1)
+			throw "Invalid activity staff ratio\n";
+
+		activities.push_back(Activity(activityName, timesPerCycle, timesAvailable, nextID++, ratio)); //add activity to activities array
+	}
+}
+
+//adds a schedule slot for each time period per level to the scheduleSlots vector, giving them the first IDs so slot IDs are indices into the schedule and match getSlotID
+void assignScheduleSlots(std::vector <ScheduleSlot>& scheduleSlots, int& nextID)
+{
+	constexpr int slotsPerLevel{ periodsInDay * daysInCycle };
+	for (int index{ 0 }; index < slotsPerLevel * static_cast<int>(Level::maxLevel); ++index)
+		scheduleSlots.emplace_back(index % slotsPerLevel, static_cast<Level>(index / slotsPerLevel), nextID++);
+}
+
+//counts the participants of each schedule slot by ID in a given chunk of whole participant rows
+void countParticipants(std::string_view chunk, std::vector <ScheduleSlot>& scheduleSlots, std::array<int, numberOfSlotIDs>& counts)
+{
+	std::vector < ScheduleSlot* > timesAvailable{};//array storing if participant is available at each time slot, reused for every row
+	while (!chunk.empty()) //while there are still participants to read in
+	{
+		std::size_t lineEnd{ chunk.find('\n') };
+		std::string line{ chunk.substr(0, lineEnd) };//holds line data
+		chunk.remove_prefix(lineEnd == std::string_view::npos ? chunk.size() : lineEnd + 1);
+		if (line.empty() || line == "\r") //skips blank lines, such as one left by a final line break
+			continue;
+
+		std::size_t comma{ line.find(',') };//location of break between participant name and times available
+		line = line.substr(comma + 1, line.size() - comma - 1); //removes participant name from line
+		char groupLevel{ line[0] };
+		Level level{ getLevel(groupLevel) }; //converts level char to Level enum type
+		line = line.substr(2, line.size() - 2); //removes participant group level from line so it only contains the participant's times available.
+
+		timesAvailable.clear();
+		getScheduleSlots(line, timesAvailable, scheduleSlots, static_cast<int>(level) * periodsInDay * daysInCycle); //gets times available from line and adds it to times avaliable vector
+
+		for (ScheduleSlot* scheduleSlot : timesAvailable) //counts the participant in the schedule slots at the times they are participating in their level
+			++counts[scheduleSlot->getID()];
+	}
+}
+
+//reads in participants and adds them to each schedule slot they are participating in
+//large sections are split into chunks of whole rows which are counted on separate threads, then the counts are added together
+//the chunks depend only on the size of the section and the threads on the hardware, so the same chunks are counted however many threads there are
+void readInParticipants(std::string_view participants, std::vector <ScheduleSlot>& scheduleSlots)
+{
+	constexpr std::size_t minimumChunkSize{ 1 << 16 }; //smaller chunks cost more to start a thread for than they save
+	std::size_t numberOfChunks{ std::max<std::size_t>(1, participants.size() / minimumChunkSize) };
+	std::size_t numberOfThreads{ std::min<std::size_t>(numberOfChunks, std::max(1u, std::thread::hardware_concurrency())) }; //each thread counts every numberOfThreads-th chunk
+
+	//splits the section into chunks of about the same size, each ending at the end of a row
+	std::vector<std::string_view> chunks{};
+	while (!participants.empty())
+	{
+		std::size_t size{ participants.size() / std::max<std::size_t>(1, numberOfChunks - std::min(numberOfChunks, chunks.size())) };
+		std::size_t end{ participants.find('\n', std::max<std::size_t>(1, size) - 1) };
+		end = end == std::string_view::npos ? participants.size() : end + 1;
+		chunks.push_back(participants.substr(0, end));
+		participants.remove_prefix(end);
+	}
+
+	std::vector<std::array<int, numberOfSlotIDs>> counts(numberOfThreads); //the counts of each thread, so the threads share nothing they write
+	std::vector<std::exception_ptr> errors(numberOfThreads); //what each thread threw, rethrown once every thread has finished
+	auto count{ [&](const std::size_t thread)
+		{
+			try
+			{
+				for (std::size_t index{ thread }; index < chunks.size(); index += numberOfThreads)
+					countParticipants(chunks[index], scheduleSlots, counts[thread]);
+			}
+			catch (...)
+			{
+				errors[thread] = std::current_exception();
+			}
+		} };
+
+	std::vector<std::thread> threads{};
+	for (std::size_t thread{ 1 }; thread < numberOfThreads; ++thread)
+		threads.emplace_back(count, thread);
+	count(0); //the first thread's chunks are counted on this thread
+	for (std::thread& thread : threads)
+		thread.join();
+
+	for (const std::exception_ptr& error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	for (ScheduleSlot& scheduleSlot : scheduleSlots)
+	{
+		int total{ 0 };
+		for (const std::array<int, numberOfSlotIDs>& threadCounts : counts)
+			total += threadCounts[scheduleSlot.getID()];
+		scheduleSlot.addParticipants(total);
+	}
+}
+
+//reads in locked assignments (day, period, group level, activity name, staff name) and stores them by spot ID in the locked assignments vector
+void readInLockedAssignments(std::istream& myReader, std::vector <ScheduleSlot>& scheduleSlots, std::vector <Activity>& activities, std::vector <Staff>& staff, std::vector <LockedAssignment>& lockedAssignments)
+{
+	std::string line{};//holds line data
+	std::getline(myReader, line); //skips first line (column headers)
+
+	while (std::getline(myReader, line)) //while there are still locked assignments to read in
+	{
+		std::vector<std::string> columns{}; //holds the columns of this line
+		std::size_t comma{ line.find(',') }; //location of the break after the next column
+		while (comma != std::string::npos)
+		{
+			columns.push_back(line.substr(0, comma));
+			line = line.substr(comma + 1, line.size() - comma - 1); //removes column from line
+			comma = line.find(',');
+		}
+		columns.push_back(line);
+
+		if (columns.size() < 5)
+			throw "Locked assignment is missing columns\n";
+
+		//slots are stored level by level, each level holding every period of every day
+		std::size_t time{ static_cast<std::size_t>((std::stoi(columns[0]) - 1) * periodsInDay + std::stoi(columns[1]) - 1) };
+		std::size_t slotIndex{ static_cast<std::size_t>(getLevel(columns[2][0])) * periodsInDay * daysInCycle + time };
+
+		std::vector<Activity*> activity{}; //holds pointer to the locked activity
+		getActivities({ columns[3] }, activity, activities);
+
+		auto lockedStaff{ std::find_if(staff.begin(), staff.end(), [&columns](Staff& member)
+		{
+			return member.getName() == columns[4];
+		}) };
+
+		if (slotIndex >= scheduleSlots.size() || activity.empty() || lockedStaff == staff.end())
+			throw "Locked assignment refers to an unknown slot, activity or staff\n";
+
+		lockedAssignments.push_back({ scheduleSlots[slotIndex].getID(), activity[0]->getID(), lockedStaff->getID() });
+	}
+}
+
+//reads in solver options from the command line arguments
+SolverOptions readInOptions(const int argc, char* argv[])
+{
+	SolverOptions options{};
+	for (int index{ 1 }; index < argc; ++index)
+	{
+		std::string_view argument{ argv[index] };
+		if (argument == "--seed" && index + 1 < argc)
+			options.seed = static_cast<std::uint32_t>(std::stoul(argv[++index]));
+		else if (argument == "--serve" && index + 1 < argc)
+			options.socketPath = argv[++index];
+		else if (argument == "--batch" && index + 1 < argc)
+			options.batchPath = argv[++index];
+		else if (argument == "--scenarios" && index + 1 < argc)
+			options.scenarioPath = argv[++index];
+		else if (argument == "--matching")
+			options.matching = true;
+		else if (argument == "--no-symmetry")
+			options.symmetry = false;
+		else if (argument == "--bench-availability")
+			options.benchmark = true;
+		else if (argument == "--time-limit" && index + 1 < argc)
+			options.timeLimit = std::stod(argv[++index]);
+		else if (argument == "--iteration-limit" && index + 1 < argc)
+			options.iterationLimit = std::stoull(argv[++index]);
+		else if (argument == "--progress")
+			options.progress = true;
+		else if (argument == "--by-day")
+			options.byDay = true;
+		else if (argument == "--pool" && index + 1 < argc)
+			options.poolSize = std::max(1, std::stoi(argv[++index]));
+		else if (argument == "--pool-distance" && index + 1 < argc)
+			options.poolDistance = std::max(1, std::stoi(argv[++index]));
+		else if (argument == "--lns" && index + 1 < argc)
+			options.neighbourhoodIterations = std::stoi(argv[++index]);
+		else if (argument == "--criticality")
+			options.criticality = true;
+		else if (argument == "--criticality-activities")
+			options.criticality = options.activityCriticality = true;
+		else if (argument == "--workers" && index + 1 < argc)
+			options.workers = std::max(1u, static_cast<unsigned int>(std::stoul(argv[++index])));
+		else
+			throw "Invalid command line argument\n";
+	}
+	return options;
+}
+
+//hashes given bytes into a given hash using FNV-1a
+std::uint64_t hashBytes(std::string_view bytes, std::uint64_t hash = 14695981039346656037ull)
+{
+	for (char byte : bytes)
+	{
+		hash ^= static_cast<unsigned char>(byte);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+//reads in the whole file with the given name, files which do not exist are read in as empty
+std::string readFile(const std::string& fileName)
+{
+	std::ifstream myReader{ fileName, std::ios::binary };
+	if (!myReader)
+		return {};
+	std::ostringstream contents{};
+	contents << myReader.rdbuf();
+	return contents.str();
+}
+
+//the input of a solve, kept in memory so that it can be solved repeatedly without reading files
+struct Roster
+{
+	std::string scheduling{}; //contents of the scheduling csv (activities, staff and participants)
+	std::string locked{}; //contents of the locked assignments csv, empty if there are no locked assignments
+};
+
+//gets a fingerprint identifying the input of a run
+std::uint64_t getInputFingerprint(const Roster& roster)
+{
+	return hashBytes(roster.locked, hashBytes(roster.scheduling));
+}
+
+//gets a canonical text of the solver options which change the schedule a run finds
+//options which only change how a run is started or reported, such as the paths, workers and progress, are left out
+std::string getOptionsText(const SolverOptions& options)
+{
+	auto limitText{ [](const auto& limit)
+		{
+			if (!limit)
+				return std::string{ "none" };
+			std::array<char, 32> text{};
+			return std::string{ text.data(), std::to_chars(text.data(), text.data() + text.size(), *limit).ptr };
+		} };
+	return "matching=" + std::to_string(options.matching)
+		+ ";symmetry=" + std::to_string(options.symmetry)
+		+ ";timeLimit=" + limitText(options.timeLimit)
+		+ ";iterationLimit=" + limitText(options.iterationLimit)
+		+ ";neighbourhoodIterations=" + std::to_string(options.neighbourhoodIterations)
+		+ ";byDay=" + std::to_string(options.byDay)
+		+ ";poolSize=" + std::to_string(options.poolSize)
+		+ ";poolDistance=" + std::to_string(options.poolDistance);
+}
+
+//gets a fingerprint identifying a run by the fingerprint of its input, its seed, its options and build so that it can be reproduced later
+std::uint64_t getRunFingerprint(const std::uint64_t inputFingerprint, const std::uint32_t seed, const SolverOptions& options)
+{
+	std::uint64_t fingerprint{ hashBytes(std::to_string(seed), inputFingerprint) };
+	fingerprint = hashBytes(getOptionsText(options), fingerprint);
+	return hashBytes(buildID, fingerprint);
+}
+
+//information identifying the run which produced a schedule, written with every output
+struct RunInfo
+{
+	std::uint32_t seed{}; //the seed of the run
+	std::uint64_t fingerprint{}; //the fingerprint of the run
+};
+
+//a solved schedule flattened into arrays indexed by slot ID, together with the names needed to read it
+//it holds no pointers into the spots that produced it, so once published as a shared_ptr<const SolvedSchedule> any number of readers can use it while the next solve runs
+struct SolvedSchedule
+{
+	Schedule schedule{}; //activity and staff filling each slot
+	std::vector<int> roomIDs{}; //index in roomNames of the room each slot occurs in, -1 if the slot has no room
+	std::vector<int> participants{}; //number of participants in each slot
+	std::vector<std::string> names{}; //display names of the activities and staff indexed by ID
+	std::vector<std::string> roomNames{}; //names of the rooms used by the slots
+	int firstStaffID{}; //staff IDs are consecutive starting at this ID
+	int numberOfStaff{}; //number of staff in the roster
+	int unfilledSlots{}; //number of slots which could not be filled
+	ScheduleScore score{}; //the quality of this schedule
+	bool budgetExhausted{ false }; //stores whether the solve stopped at its time or iteration limit, leaving slots it had not tried unfilled
+	std::uint64_t solveNumber{ 0 }; //the number of the server solve which produced this schedule, 0 outside server mode
+	RunInfo run{}; //identifies the run which produced this schedule
+	std::vector<Schedule> alternatives{}; //the rest of the pool when more than one schedule was asked for, best first
+	std::vector<ScheduleScore> alternativeScores{}; //the quality of each alternative
+};
+
+//gets the display names of the activities and staff indexed by their ID
+std::vector<std::string> getSpotNames(const std::vector<Activity>& activities, const std::vector<Staff>& staff)
+{
+	std::vector<std::string> names(getNumberOfSpotIDs(activities, staff));
+	for (const Activity& activity : activities)
+		names[activity.getID()] = activity.getName();
+	for (const Staff& member : staff)
+		names[member.getID()] = member.getName();
+	return names;
+}
+
+//adds the day, period and level of the slot with the given ID as csv columns to the given output
+void appendSlotColumns(std::string& output, const int slotID)
+{
+	int time{ slotID % (periodsInDay * daysInCycle) }; //slots are stored level by level, each level holding every period of every day
+	output += std::to_string(time / periodsInDay + 1);
+	output += ',';
+	output += std::to_string(time % periodsInDay + 1);
+	output += ',';
+	output += static_cast<char>('A' + slotID / (periodsInDay * daysInCycle));
+}
+
+//adds a given string to the given output as a json string
+void appendJsonString(std::string& output, std::string_view string)
+{
+	constexpr char hexDigits[]{ "0123456789abcdef" };
+
+	output += '"';
+	for (char c : string)
+	{
+		if (static_cast<unsigned char>(c) < 0x20) //control characters such as a tab or line break pasted into a name must be escaped to be valid json
+		{
+			output += "\\u00";
+			output += hexDigits[static_cast<unsigned char>(c) >> 4];
+			output += hexDigits[static_cast<unsigned char>(c) & 0xF];
+			continue;
+		}
+		if (c == '"' || c == '\\')
+			output += '\\';
+		output += c;
+	}
+	output += '"';
+}
+
+//writes a given output to the file with the given name in one write
+void writeFile(const std::string& fileName, std::string_view output)
+{
+	std::ofstream myWriter{ fileName, std::ios::binary };
+	if (!myWriter)
+		throw "Output file could not be opened\n";
+	myWriter.write(output.data(), static_cast<std::streamsize>(output.size()));
+}
+
+//groups the filled slots of a schedule by staff member in one pass, slots of the staff with index i are slotIDs[offsets[i]] to slotIDs[offsets[i + 1]]
+//a slot is in the timetable of every staff member on its team
+struct StaffTimetables
+{
+	std::vector<std::size_t> offsets{}; //start of each staff member's slots in slotIDs, with one extra entry for the end of the last staff member
+	std::vector<int> slotIDs{}; //IDs of the filled slots ordered by staff member then time
+
+	//staff IDs are consecutive from the given first staff ID so they can be used as indices
+	StaffTimetables(const Schedule& schedule, const int firstStaffID, const int numberOfStaff)
+		: offsets(numberOfStaff + 1, 0),
+		slotIDs{}
+	{
+
+		//counts the slots of each staff member and converts the counts into offsets
+		for (std::size_t slotID{ 0 }; slotID < schedule.staffIDs.size(); ++slotID)
+		{
+			schedule.forEachStaff(static_cast<int>(slotID), [this, firstStaffID](const int staffID)
+				{
+					++offsets[staffID - firstStaffID + 1];
+				});
+		}
+		for (std::size_t index{ 1 }; index < offsets.size(); ++index)
+			offsets[index] += offsets[index - 1];
+
+		//places each slot after the slots of the same staff member placed before it
+		slotIDs.resize(offsets.back());
+		std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+		for (std::size_t slotID{ 0 }; slotID < schedule.staffIDs.size(); ++slotID)
+		{
+			schedule.forEachStaff(static_cast<int>(slotID), [this, &next, firstStaffID, slotID](const int staffID)
+				{
+					slotIDs[next[staffID - firstStaffID]++] = static_cast<int>(slotID);
+				});
+		}
+	}
+};
+
+//gets the fingerprint of a run as a hexidecimal string
+std::string getFingerprintString(const RunInfo& run)
+{
+	std::ostringstream fingerprint{};
+	fingerprint << std::hex << std::setw(16) << std::setfill('0') << run.fingerprint;
+	return fingerprint.str();
+}
+
+//adds the run information line that starts every csv output to the given output
+void appendCsvRunLine(std::string& output, const RunInfo& run)
+{
+	output += "Run fingerprint,";
+	output += getFingerprintString(run);
+	output += ",Seed,";
+	output += std::to_string(run.seed);
+	output += '\n';
+}
+
+//adds the names of the team filling a slot to the given output, the lead first and then each assistant after an '&'
+void appendTeamNames(std::string& output, const SolvedSchedule& snapshot, const int slotID)
+{
+	bool first{ true };
+	snapshot.schedule.forEachStaff(slotID, [&output, &snapshot, &first](const int staffID)
+		{
+			if (!first)
+				output += " & ";
+			first = false;
+			output += snapshot.names[staffID];
+		});
+}
+
+//writes the master grid, one row per period and one activity/staff column pair per level
+void writeMasterGridCsv(const std::string& fileName, const SolvedSchedule& snapshot)
+{
+	const Schedule& schedule{ snapshot.schedule };
+	const std::vector<std::string>& names{ snapshot.names };
+	constexpr int slotsPerLevel{ periodsInDay * daysInCycle };
+	std::string output{};
+	output.reserve(schedule.activityIDs.size() * 32);
+	appendCsvRunLine(output, snapshot.run);
+
+	output += "Day,Period";
+	for (int level{ 0 }; level < static_cast<int>(Level::maxLevel); ++level)
+	{
+		output += ",Level ";
+		output += static_cast<char>('A' + level);
+		output += " Activity,Level ";
+		output += static_cast<char>('A' + level);
+		output += " Staff";
+	}
+	output += '\n';
+
+	for (int time{ 0 }; time < slotsPerLevel; ++time)
+	{
+		output += std::to_string(time / periodsInDay + 1);
+		output += ',';
+		output += std::to_string(time % periodsInDay + 1);
+		for (int slotID{ time }; slotID < static_cast<int>(schedule.activityIDs.size()); slotID += slotsPerLevel)
+		{
+			output += ',';
+			if (schedule.isFilled(slotID))
+			{
+				output += names[schedule.activityIDs[slotID]];
+				output += ',';
+				appendTeamNames(output, snapshot, slotID);
+			}
+			else
+				output += ',';
+		}
+		output += '\n';
+	}
+	writeFile(fileName, output);
+}
+
+//writes every staff member's timetable, one row per slot they lead
+void writeStaffTimetablesCsv(const std::string& fileName, const SolvedSchedule& snapshot, const StaffTimetables& timetables)
+{
+	const Schedule& schedule{ snapshot.schedule };
+	const std::vector<std::string>& names{ snapshot.names };
+	std::string output{};
+	output.reserve(timetables.slotIDs.size() * 48);
+	appendCsvRunLine(output, snapshot.run);
+	output += "Staff,Day,Period,Level,Activity\n";
+
+	for (std::size_t staffIndex{ 0 }; staffIndex < static_cast<std::size_t>(snapshot.numberOfStaff); ++staffIndex)
+	{
+		for (std::size_t index{ timetables.offsets[staffIndex] }; index < timetables.offsets[staffIndex + 1]; ++index)
+		{
+			int slotID{ timetables.slotIDs[index] };
+			output += names[snapshot.firstStaffID + staffIndex];
+			output += ',';
+			appendSlotColumns(output, slotID);
+			output += ',';
+			output += names[schedule.activityIDs[slotID]];
+			output += '\n';
+		}
+	}
+	writeFile(fileName, output);
+}
+
+//writes every level's timetable, one row per filled slot ordered by level then time
+void writeLevelTimetablesCsv(const std::string& fileName, const SolvedSchedule& snapshot)
+{
+	const Schedule& schedule{ snapshot.schedule };
+	const std::vector<std::string>& names{ snapshot.names };
+	std::string output{};
+	output.reserve(schedule.activityIDs.size() * 48);
+	appendCsvRunLine(output, snapshot.run);
+	output += "Level,Day,Period,Activity,Staff,Participants\n";
+
+	//slot IDs are ordered by level then time so a single pass over the slots gives each level's timetable in order
+	for (int slotID{ 0 }; slotID < static_cast<int>(schedule.activityIDs.size()); ++slotID)
+	{
+		if (!schedule.isFilled(slotID))
+			continue;
+		int time{ slotID % (periodsInDay * daysInCycle) };
+		output += static_cast<char>('A' + slotID / (periodsInDay * daysInCycle));
+		output += ',';
+		output += std::to_string(time / periodsInDay + 1);
+		output += ',';
+		output += std::to_string(time % periodsInDay + 1);
+		output += ',';
+		output += names[schedule.activityIDs[slotID]];
+		output += ',';
+		appendTeamNames(output, snapshot, slotID);
+		output += ',';
+		output += std::to_string(snapshot.participants[slotID]);
+		output += '\n';
+	}
+	writeFile(fileName, output);
+}
+
+//adds a slot as a json object with the given fields to the given output
+void appendJsonSlot(std::string& output, const int slotID, std::string_view nameField, std::string_view name, std::string_view otherField, std::string_view other)
+{
+	int time{ slotID % (periodsInDay * daysInCycle) };
+	output += "{\"day\":";
+	output += std::to_string(time / periodsInDay + 1);
+	output += ",\"period\":";
+	output += std::to_string(time % periodsInDay + 1);
+	output += ",\"level\":\"";
+	output += static_cast<char>('A' + slotID / (periodsInDay * daysInCycle));
+	output += "\",\"";
+	output += nameField;
+	output += "\":";
+	appendJsonString(output, name);
+	if (!otherField.empty())
+	{
+		output += ",\"";
+		output += otherField;
+		output += "\":";
+		appendJsonString(output, other);
+	}
+	output += '}';
+}
+
+//writes the master grid, staff timetables and level timetables in a single json file
+void writeScheduleJson(const std::string& fileName, const SolvedSchedule& snapshot, const StaffTimetables& timetables)
+{
+	const Schedule& schedule{ snapshot.schedule };
+	const std::vector<std::string>& names{ snapshot.names };
+	std::string output{};
+	output.reserve(schedule.activityIDs.size() * 160);
+
+	output += "{\"run\":{\"fingerprint\":\"";
+	output += getFingerprintString(snapshot.run);
+	output += "\",\"seed\":";
+	output += std::to_string(snapshot.run.seed);
+	output += "},\n\"slots\":[";
+
+	//master grid in slot order, which is also level then time order
+	bool first{ true };
+	for (int slotID{ 0 }; slotID < static_cast<int>(schedule.activityIDs.size()); ++slotID)
+	{
+		if (!schedule.isFilled(slotID))
+			continue;
+		if (!first)
+			output += ',';
+		first = false;
+		appendJsonSlot(output, slotID, "activity", names[schedule.activityIDs[slotID]], "staff", names[schedule.staffIDs[slotID]]);
+		output.pop_back(); //reopens the slot object to add its participants
+		output += ",\"participants\":";
+		output += std::to_string(snapshot.participants[slotID]);
+		if (!schedule.assistantIDs[slotID].empty())
+		{
+			output += ",\"assistants\":[";
+			for (std::size_t index{ 0 }; index < schedule.assistantIDs[slotID].size(); ++index)
+			{
+				if (index != 0)
+					output += ',';
+				appendJsonString(output, names[schedule.assistantIDs[slotID][index]]);
+			}
+			output += ']';
+		}
+		output += '}';
+	}
+
+	output += "],\n\"staff\":{";
+	for (std::size_t staffIndex{ 0 }; staffIndex < static_cast<std::size_t>(snapshot.numberOfStaff); ++staffIndex)
+	{
+		if (staffIndex != 0)
+			output += ',';
+		appendJsonString(output, names[snapshot.firstStaffID + staffIndex]);
+		output += ":[";
+		for (std::size_t index{ timetables.offsets[staffIndex] }; index < timetables.offsets[staffIndex + 1]; ++index)
+		{
+			if (index != timetables.offsets[staffIndex])
+				output += ',';
+			int slotID{ timetables.slotIDs[index] };
+			appendJsonSlot(output, slotID, "activity", names[schedule.activityIDs[slotID]], {}, {});
+		}
+		output += ']';
+	}
+	output += "}}\n";
+	writeFile(fileName, output);
+}
+
+//writes the master grid, per staff and per level views of a schedule as csv and the whole schedule as json
+//the file names start with the given prefix so that the schedules of a batch do not overwrite each other
+void writeSchedule(const SolvedSchedule& snapshot, const std::string& prefix = {})
+{
+	StaffTimetables timetables{ snapshot.schedule, snapshot.firstStaffID, snapshot.numberOfStaff }; //groups slots by staff once for both the csv and json outputs
+
+	writeMasterGridCsv(prefix + "schedule_master.csv", snapshot);
+	writeStaffTimetablesCsv(prefix + "schedule_staff.csv", snapshot, timetables);
+	writeLevelTimetablesCsv(prefix + "schedule_levels.csv", snapshot);
+	writeScheduleJson(prefix + "schedule.json", snapshot, timetables);
+
+	//the rest of a pool is written with the same views, numbered from 2 after the solved schedule
+	if (snapshot.alternatives.empty())
+		return;
+	SolvedSchedule alternative{ snapshot };
+	alternative.alternatives.clear();
+	for (std::size_t index{ 0 }; index < snapshot.alternatives.size(); ++index)
+	{
+		alternative.schedule = snapshot.alternatives[index];
+		alternative.score = snapshot.alternativeScores[index];
+		alternative.unfilledSlots = alternative.score.unfilledSlots;
+		writeSchedule(alternative, prefix + "pool_" + std::to_string(index + 2) + '_');
+	}
+}
+
+//gets the fewest times a spot should be filled, activities must occur every time they are scheduled
+int getMinimumTimes(const Activity& activity)
+{
+	return activity.getTimesPerCycle();
+}
+
+//gets the fewest times a spot should be filled, staff should lead at least their minimum load
+int getMinimumTimes(const Staff& member)
+{
+	return member.getLimits().minimumLoad;
+}
+
+//fills given fill list with up to length spots to be filled, stopping early if every spot has been added its times per cycle
+//spots below their minimum come first, then the spot with the highest ratio of remaining times to times per cycle
+//ratios are compared by cross multiplying so no precision is lost and ties go to the spot read in first so the order is reproducible
+//the times each spot is locked, by ID, are left out of the list since the participant group holding each locked slot adds those times to its part of it
+template <typename T>
+void fillFillList(std::vector <SpotId<T>>& spotsToFill, std::vector <T>& spots, const std::size_t length, const std::vector<int>& locked)
+{
+	std::vector<int> added(spots.size(), 0); //number of times each spot has been added to the list
+	for (std::size_t index{ 0 }; index < length; ++index)
+	{
+		std::size_t next{ spots.size() }; //the index of the spot to add next, spots.size() if none is left
+		for (std::size_t spotIndex{ 0 }; spotIndex < spots.size(); ++spotIndex)
+		{
+			int total{ spots[spotIndex].getTimesPerCycle() - locked[static_cast<std::size_t>(spots[spotIndex].getID())] };
+			if (added[spotIndex] >= total)
+				continue;
+			if (next == spots.size())
+			{
+				next = spotIndex;
+				continue;
+			}
+
+			bool belowMinimum{ added[spotIndex] < getMinimumTimes(spots[spotIndex]) - locked[static_cast<std::size_t>(spots[spotIndex].getID())] };
+			bool nextBelowMinimum{ added[next] < getMinimumTimes(spots[next]) - locked[static_cast<std::size_t>(spots[next].getID())] };
+			int nextTotal{ spots[next].getTimesPerCycle() - locked[static_cast<std::size_t>(spots[next].getID())] };
+			if (belowMinimum != nextBelowMinimum ? belowMinimum
+				: static_cast<long long>(total - added[spotIndex]) * nextTotal > static_cast<long long>(nextTotal - added[next]) * total)
+				next = spotIndex;
+		}
+		if (next == spots.size())
+			break;
+
+		//adds found spot as next in list and updates accordingly
+		spotsToFill.push_back(getSpotId(spots[next]));
+		++added[next];
+	}
+}
+
+
+//the sections of a scheduling csv, each holding whole lines including their line breaks
+struct RosterSections
+{
+	std::string_view header{}; //the column headers
+	std::string_view activities{}; //the activity rows
+	std::string_view staffLine{}; //the line which ends the activities and starts the staff, empty if there is none
+	std::string_view staff{}; //the staff rows
+	std::string_view participantLine{}; //the line which ends the staff and starts the participants, empty if there is none
+	std::string_view participants{}; //the participant rows, by far the largest section
+};
+
+//finds the sections of a scheduling csv by scanning for the lines whose first column is "Staff" and then "Partcipants"
+//only the line breaks and first columns are looked at, so the participants are found without reading the rows before them
+RosterSections findRosterSections(std::string_view scheduling)
+{
+	RosterSections sections{};
+	std::string_view* section{ &sections.header };
+	std::size_t start{ 0 }; //the start of the section being scanned
+	std::size_t lineStart{ 0 };
+	while (lineStart < scheduling.size())
+	{
+		std::size_t lineEnd{ scheduling.find('\n', lineStart) };
+		lineEnd = lineEnd == std::string_view::npos ? scheduling.size() : lineEnd + 1;
+		std::string_view line{ scheduling.substr(lineStart, lineEnd - lineStart) };
+		std::string_view name{ line.substr(0, line.find_first_of(",\r\n")) };
+
+		if (section == &sections.header) //the headers are always one line
+		{
+			sections.header = line;
+			section = &sections.activities;
+			start = lineEnd;
+		}
+		else if ((section == &sections.activities && name == "Staff") || (section == &sections.staff && name == "Partcipants"))
+		{
+			bool isStaffLine{ section == &sections.activities };
+			*section = scheduling.substr(start, lineStart - start);
+			(isStaffLine ? sections.staffLine : sections.participantLine) = line;
+			section = isStaffLine ? &sections.staff : &sections.participants; //the rows follow their line
+			start = lineEnd;
+		}
+		lineStart = lineEnd;
+	}
+	if (section != &sections.header)
+		*section = scheduling.substr(start);
+	return sections;
+}
+
+//reads in the spots and locked assignments of a roster
+void readInRoster(const Roster& roster, std::vector <ScheduleSlot>& scheduleSlots, std::vector <Activity>& activities, std::vector <Staff>& staff, std::vector <LockedAssignment>& lockedAssignments)
+{
+	int nextID{ 0 }; //IDs are numbered per roster so that slot IDs are indices into the schedule and rosters can be read in at the same time
+
+	assignScheduleSlots(scheduleSlots, nextID);
+
+	RosterSections sections{ findRosterSections(roster.scheduling) }; //finds the sections first so the participants can be split between threads
+	if (sections.staffLine.empty() || sections.participantLine.empty())
+		throw "Scheduling csv is missing its Staff or Partcipants line\n";
+
+	std::istringstream activityReader{ std::string{ sections.activities } }; //reads the roster from memory rather than from a file
+	readInActivities(activityReader, activities, scheduleSlots, nextID); //reads in activities and assigns them to the activities vector
+	std::istringstream staffReader{ std::string{ sections.staff } };
+	readInStaff(staffReader, activities, staff, scheduleSlots, nextID); //reads in staff
+	if (nextID > SpotId<SpotWrapper>::none) //spots refer to each other by 16 bit IDs
+		throw "Roster has too many activities and staff\n";
+	readInParticipants(sections.participants, scheduleSlots); //reads in paticipants
+
+	if (!roster.locked.empty()) //locked assignments are only read in when the roster has them
+	{
+		std::istringstream lockedReader{ roster.locked };
+		readInLockedAssignments(lockedReader, scheduleSlots, activities, staff, lockedAssignments);
+	}
+}
+
+//the spots of a roster once read in, which each solve copies so that a roster can be solved repeatedly without reading it in again
+struct LoadedRoster
+{
+	std::vector <ScheduleSlot> scheduleSlots{};
+	std::vector <Activity> activities{};
+	std::vector <Staff> staff{};
+	std::vector <LockedAssignment> lockedAssignments{}; //holds assignments which must appear in the generated schedule
+};
+
+//reads in a given roster's spots
+LoadedRoster loadRoster(const Roster& roster)
+{
+	LoadedRoster loaded{};
+	readInRoster(roster, loaded.scheduleSlots, loaded.activities, loaded.staff, loaded.lockedAssignments);
+	return loaded;
+}
+
+//prints the shortages found before solving and stops the solve if there are any
+void reportShortages(const std::vector<std::string>& shortages)
+{
+	if (shortages.empty())
+		return;
+	for (const std::string& shortage : shortages)
+		std::cerr << shortage << '\n';
+	throw "Roster cannot be scheduled\n";
+}
+
+//the times of the cycle at which a spot is available, shared by every level
+using TimeSet = std::bitset<daysInCycle * periodsInDay>;
+
+//gets the times at which a given spot is available
+TimeSet getTimeSet(SpotWrapper& spot)
+{
+	TimeSet times{};
+	for (SlotId slot : spot.getTimesAvailable())
+		times.set(getSlotTime(slot.get()));
+	return times;
+}
+
+//a flow network with integer capacities, used to check Hall's condition for every set of slots at once
+//by Hall's theorem every slot can be given a resource exactly when the maximum flow from the resources to the slots fills every slot
+class HallFlow
+{
+	//an edge of the flow network, stored with the index of its reverse edge in the adjacency list of its destination
+	struct Edge
+	{
+		int to{};
+		int reverse{};
+		int capacity{};
+	};
+
+	std::vector<std::vector<Edge>> m_graph{}; //adjacency lists of the flow network
+
+public:
+
+	//creates a network with a given number of nodes and no edges
+	explicit HallFlow(const int numberOfNodes)
+		: m_graph(static_cast<std::size_t>(numberOfNodes))
+	{
+	}
+
+	//adds an edge with a given capacity and its reverse residual edge to the network
+	void addEdge(const int from, const int to, const int capacity)
+	{
+		if (capacity <= 0)
+			return;
+		m_graph[from].push_back({ to, static_cast<int>(m_graph[to].size()), capacity });
+		m_graph[to].push_back({ from, static_cast<int>(m_graph[from].size()) - 1, 0 });
+	}
+
+	//finds the maximum flow from a given source to a given sink by augmenting along shortest paths
+	int getMaximumFlow(const int source, const int sink)
+	{
+		int flow{ 0 };
+		std::vector<int> previousNode(m_graph.size());
+		std::vector<int> previousEdge(m_graph.size());
+		std::deque<int> queue{};
+		while (true)
+		{
+			std::fill(previousNode.begin(), previousNode.end(), -1);
+			previousNode[source] = source;
+			queue.assign(1, source);
+			while (!queue.empty() && previousNode[sink] == -1)
+			{
+				int node{ queue.front() };
+				queue.pop_front();
+				for (std::size_t edgeIndex{ 0 }; edgeIndex < m_graph[node].size(); ++edgeIndex)
+				{
+					const Edge& edge{ m_graph[node][edgeIndex] };
+					if (edge.capacity > 0 && previousNode[edge.to] == -1)
+					{
+						previousNode[edge.to] = node;
+						previousEdge[edge.to] = static_cast<int>(edgeIndex);
+						queue.push_back(edge.to);
+					}
+				}
+			}
+			if (previousNode[sink] == -1) //no more flow can reach the sink
+				return flow;
+
+			//pushes as much flow along the path as its smallest capacity allows
+			int pushed{ std::numeric_limits<int>::max() };
+			for (int node{ sink }; node != source; node = previousNode[node])
+				pushed = std::min(pushed, m_graph[previousNode[node]][previousEdge[node]].capacity);
+			for (int node{ sink }; node != source; node = previousNode[node])
+			{
+				Edge& edge{ m_graph[previousNode[node]][previousEdge[node]] };
+				edge.capacity -= pushed;
+				m_graph[node][edge.reverse].capacity += pushed;
+			}
+			flow += pushed;
+		}
+	}
+};
+
+//gets a readable name for a given time
+std::string getTimeName(const int time)
+{
+	return "day " + std::to_string(time / periodsInDay + 1) + " period " + std::to_string(time % periodsInDay + 1);
+}
+
+//checks that every locked assignment can be filled as given, adding a description of each one which cannot to the shortages
+//a locked slot must have its activity and staff available and able to lead it, each slot and each spot at a time can only be locked once, and no spot can be locked more often than it is filled
+//the locks of each staff member must also keep within their daily cap and consecutive limit, since the fills count locked slots towards them
+void checkLockedAssignments(std::vector <ScheduleSlot>& scheduleSlots, std::vector <Activity>& activities, std::vector <Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, std::vector<std::string>& shortages)
+{
+	if (lockedAssignments.empty())
+		return;
+
+	std::vector<ScheduleSlot*> slots(scheduleSlots.size(), nullptr); //the slots by ID, since they may already have been sorted
+	for (ScheduleSlot& slot : scheduleSlots)
+		slots[static_cast<std::size_t>(slot.getID())] = &slot;
+	int firstActivityID{ activities.empty() ? 0 : activities[0].getID() };
+	int firstStaffID{ staff.empty() ? 0 : staff[0].getID() };
+
+	std::vector<int> locked(getNumberOfSpotIDs(activities, staff), 0); //the times each spot is locked, by ID
+	std::vector<int> lockedAtTime(locked.size(), -1); //the time of the last lock checked for each spot, locks at the same time are found by sorting
+	std::vector<TimeSet> staffLockedTimes(staff.size()); //the times each staff member is locked at
+	std::vector<const LockedAssignment*> byTime{};
+	for (const LockedAssignment& lockedAssignment : lockedAssignments)
+		byTime.push_back(&lockedAssignment);
+	std::stable_sort(byTime.begin(), byTime.end(), [](const LockedAssignment* first, const LockedAssignment* second)
+		{
+			return getSlotTime(first->slotID) < getSlotTime(second->slotID);
+		});
+
+	SlotMask lockedSlots{};
+	for (const LockedAssignment* lockedAssignment : byTime)
+	{
+		ScheduleSlot& slot{ *slots[static_cast<std::size_t>(lockedAssignment->slotID)] };
+		Activity& activity{ activities[static_cast<std::size_t>(lockedAssignment->activityID - firstActivityID)] };
+		Staff& member{ staff[static_cast<std::size_t>(lockedAssignment->staffID - firstStaffID)] };
+		int time{ slot.getTime() };
+		std::string lock{ std::string{ activity.getName() } + " with " + std::string{ member.getName() } + " at " + getTimeName(time) };
+
+		if (lockedSlots.test(slot.getID()))
+			shortages.push_back("Locked assignment of " + lock + " is in a slot which is already locked");
+		lockedSlots.set(slot.getID());
+
+		SpotList<SpotWrapper>& available{ slot.getAvailableSpots() };
+		bool leads{ false };
+		for (SpotList<Staff>* leaders : { &activity.getPreferredStaff(), &activity.getNeutralStaff(), &activity.getUnpreferredStaff() })
+			leads = leads || leaders->contains(getSpotId(member));
+		if (!available.contains(SpotId<SpotWrapper>{ activity.getID() }) || !available.contains(SpotId<SpotWrapper>{ member.getID() }))
+			shortages.push_back("Locked assignment of " + lock + " is not available at its slot");
+		else if (!leads)
+			shortages.push_back("Locked assignment of " + lock + " has staff who cannot lead the activity");
+
+		for (int spotID : { activity.getID(), member.getID() })
+		{
+			if (lockedAtTime[static_cast<std::size_t>(spotID)] == time)
+				shortages.push_back("Locked assignment of " + lock + " is at the same time as another lock of " + std::string{ spotID == activity.getID() ? activity.getName() : member.getName() });
+			lockedAtTime[static_cast<std::size_t>(spotID)] = time;
+			++locked[static_cast<std::size_t>(spotID)];
+		}
+		staffLockedTimes[static_cast<std::size_t>(member.getID() - firstStaffID)].set(static_cast<std::size_t>(time));
+	}
+
+	//the fills only give each spot its times per cycle, so a spot locked more often than that could not fill its locks
+	for (Activity& activity : activities)
+	{
+		if (locked[static_cast<std::size_t>(activity.getID())] > activity.getTimesPerCycle())
+			shortages.push_back("Activity " + std::string{ activity.getName() } + " is locked into " + std::to_string(locked[static_cast<std::size_t>(activity.getID())]) + " slots but only occurs " + std::to_string(activity.getTimesPerCycle()) + " times");
+	}
+	for (Staff& member : staff)
+	{
+		if (locked[static_cast<std::size_t>(member.getID())] > member.getTimesPerCycle())
+			shortages.push_back("Staff " + std::string{ member.getName() } + " is locked into " + std::to_string(locked[static_cast<std::size_t>(member.getID())]) + " slots but only leads " + std::to_string(member.getTimesPerCycle()) + " times");
+
+		const TimeSet& lockedTimes{ staffLockedTimes[static_cast<std::size_t>(member.getID() - firstStaffID)] };
+		const StaffLimits& limits{ member.getLimits() };
+		for (int day{ 0 }; day < daysInCycle; ++day)
+		{
+			int onDay{ 0 }; //the slots locked on this day
+			int run{ 0 }; //the periods in a row locked up to the current period
+			int longestRun{ 0 };
+			for (int period{ 0 }; period < periodsInDay; ++period)
+			{
+				run = lockedTimes[static_cast<std::size_t>(day * periodsInDay + period)] ? run + 1 : 0;
+				onDay += run != 0;
+				longestRun = std::max(longestRun, run);
+			}
+			if (onDay > limits.dailyCap)
+				shortages.push_back("Staff " + std::string{ member.getName() } + " is locked into " + std::to_string(onDay) + " slots on day " + std::to_string(day + 1) + " but can only lead " + std::to_string(limits.dailyCap) + " a day");
+			if (longestRun > limits.maxConsecutive)
+				shortages.push_back("Staff " + std::string{ member.getName() } + " is locked into " + std::to_string(longestRun) + " periods in a row on day " + std::to_string(day + 1) + " but can only lead " + std::to_string(limits.maxConsecutive) + " in a row");
+		}
+	}
+}
+
+//checks capacity bounds which every schedule must meet before solving, returns a description of each resource which is short
+//an activity or staff member can fill one slot per time, so each time needs as many leadable activities and staff as it has slots
+//the counting checks are a single pass over the spots and their preference lists, the Hall checks then bound every set of slots at once with a flow
+//these are necessary conditions, a roster which passes them can still be impossible once activities and staff have to be paired in the same slots
+std::vector<std::string> checkFeasibility(std::vector <ScheduleSlot>& scheduleSlots, std::vector <Activity>& activities, std::vector <Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments)
+{
+	constexpr int numberOfTimes{ daysInCycle * periodsInDay };
+	std::vector<std::string> shortages{}; //holds a description of each resource which is short
+
+	std::array<int, numberOfTimes> slotsAtTime{}; //the number of slots to fill at each time
+	std::array<int, numberOfTimes> activitiesAtTime{}; //the number of activities which can be led at each time
+	std::array<int, numberOfTimes> staffAtTime{}; //the number of staff who can lead an activity at each time
+
+	for (ScheduleSlot& slot : scheduleSlots)
+		++slotsAtTime[slot.getTime()];
+
+	int firstStaffID{ staff.empty() ? 0 : staff[0].getID() }; //staff IDs are consecutive so they can be used as indices
+	std::vector<TimeSet> staffTimes(staff.size()); //the times each staff member is available
+	std::vector<TimeSet> staffLeadTimes(staff.size()); //the times each staff member is available with an activity they can lead
+	for (std::size_t index{ 0 }; index < staff.size(); ++index)
+		staffTimes[index] = getTimeSet(staff[index]);
+
+	int activityTimes{ 0 }; //the total number of times activities must occur
+	int activitySlots{ 0 }; //the most slots the activities can fill between them
+	std::vector<TimeSet> activityLeadTimes{}; //the times each activity is available with a staff member who can lead it
+	for (Activity& activity : activities)
+	{
+		TimeSet times{ getTimeSet(activity) };
+		TimeSet leadTimes{}; //the times at which this activity is available with a staff member who can lead it
+
+		for (SpotList<Staff>* leaders : { &activity.getPreferredStaff(), &activity.getNeutralStaff(), &activity.getUnpreferredStaff() })
+		{
+			for (StaffId leader : *leaders)
+			{
+				TimeSet common{ times & staffTimes[leader.get() - firstStaffID] };
+				leadTimes |= common;
+				staffLeadTimes[leader.get() - firstStaffID] |= common;
+			}
+		}
+
+		for (int time{ 0 }; time < numberOfTimes; ++time)
+			activitiesAtTime[time] += leadTimes[time];
+		activityLeadTimes.push_back(leadTimes);
+
+		int available{ static_cast<int>(leadTimes.count()) };
+		if (activity.getTimesPerCycle() > available)
+			shortages.push_back("Activity " + std::string{ activity.getName() } + " must occur " + std::to_string(activity.getTimesPerCycle()) + " times but can only be led at " + std::to_string(available) + " times");
+		int leaders{ static_cast<int>(activity.getPreferredStaff().size() + activity.getNeutralStaff().size() + activity.getUnpreferredStaff().size()) };
+		if (activity.getStaffRatio().minimumStaff > leaders)
+			shortages.push_back("Activity " + std::string{ activity.getName() } + " needs " + std::to_string(activity.getStaffRatio().minimumStaff) + " staff but only " + std::to_string(leaders) + " can lead it");
+		activityTimes += activity.getTimesPerCycle();
+		activitySlots += std::min(activity.getTimesPerCycle(), available);
+	}
+
+	int staffSlots{ 0 }; //the most slots the staff can lead between them
+	int minimumLoads{ 0 }; //the fewest slots the staff should lead between them
+	std::vector<int> staffPerDay(staff.size()); //the most slots each staff member can lead in one day
+	for (std::size_t index{ 0 }; index < staff.size(); ++index)
+	{
+		for (int time{ 0 }; time < numberOfTimes; ++time)
+			staffAtTime[time] += staffLeadTimes[index][time];
+
+		//each day's slots are limited by the daily cap and by needing a free period after every max consecutive periods
+		const StaffLimits& limits{ staff[index].getLimits() };
+		int perDay{ std::min(limits.dailyCap, periodsInDay - periodsInDay / (limits.maxConsecutive + 1)) };
+		staffPerDay[index] = perDay;
+		int available{ 0 };
+		for (int day{ 0 }; day < daysInCycle; ++day)
+		{
+			int availableOnDay{ 0 };
+			for (int period{ 0 }; period < periodsInDay; ++period)
+				availableOnDay += staffLeadTimes[index][day * periodsInDay + period];
+			available += std::min(perDay, availableOnDay);
+		}
+
+		if (limits.minimumLoad > available)
+			shortages.push_back("Staff " + std::string{ staff[index].getName() } + " must lead at least " + std::to_string(limits.minimumLoad) + " times but can only lead at " + std::to_string(available) + " times within their workload limits");
+		staffSlots += std::min(limits.maximumLoad, available);
+		minimumLoads += limits.minimumLoad;
+	}
+
+	//each time needs a different activity and staff member for each of its slots
+	for (int time{ 0 }; time < numberOfTimes; ++time)
+	{
+		if (activitiesAtTime[time] < slotsAtTime[time])
+			shortages.push_back("At " + getTimeName(time) + " there are " + std::to_string(slotsAtTime[time]) + " slots but only " + std::to_string(activitiesAtTime[time]) + " activities can be led");
+		if (staffAtTime[time] < slotsAtTime[time])
+			shortages.push_back("At " + getTimeName(time) + " there are " + std::to_string(slotsAtTime[time]) + " slots but only " + std::to_string(staffAtTime[time]) + " staff can lead an activity");
+	}
+
+	int numberOfSlots{ static_cast<int>(scheduleSlots.size()) };
+
+	//Hall's condition for the activities: every set of slots needs activities which can fill at least as many of them
+	//an activity can fill any level's slot at a time it can be led, so the slots are grouped by time: source -> activity -> time -> sink
+	//each activity sends at most its times per cycle, and at most one slot at each time, and each time takes at most its number of slots
+	int hallActivitySlots{ 0 }; //the most slots the activities can fill between them at the times they can be led
+	{
+		const int source{ 0 };
+		const int firstTime{ static_cast<int>(activities.size()) + 1 };
+		const int sink{ firstTime + numberOfTimes };
+		HallFlow flow{ sink + 1 };
+		for (std::size_t index{ 0 }; index < activities.size(); ++index)
+		{
+			flow.addEdge(source, static_cast<int>(index) + 1, activities[index].getTimesPerCycle());
+			for (int time{ 0 }; time < numberOfTimes; ++time)
+			{
+				if (activityLeadTimes[index][time])
+					flow.addEdge(static_cast<int>(index) + 1, firstTime + time, 1);
+			}
+		}
+		for (int time{ 0 }; time < numberOfTimes; ++time)
+			flow.addEdge(firstTime + time, sink, slotsAtTime[time]);
+		hallActivitySlots = flow.getMaximumFlow(source, sink);
+	}
+
+	//Hall's condition for the staff, with each staff member's slots on a day limited by their workload limits: source -> staff -> staff day -> time -> sink
+	int hallStaffSlots{ 0 }; //the most slots the staff can lead between them at the times they are available
+	{
+		const int source{ 0 };
+		const int firstDay{ static_cast<int>(staff.size()) + 1 };
+		const int firstTime{ firstDay + static_cast<int>(staff.size()) * daysInCycle };
+		const int sink{ firstTime + numberOfTimes };
+		HallFlow flow{ sink + 1 };
+		for (std::size_t index{ 0 }; index < staff.size(); ++index)
+		{
+			flow.addEdge(source, static_cast<int>(index) + 1, staff[index].getLimits().maximumLoad);
+			for (int day{ 0 }; day < daysInCycle; ++day)
+			{
+				int dayNode{ firstDay + static_cast<int>(index) * daysInCycle + day };
+				flow.addEdge(static_cast<int>(index) + 1, dayNode, staffPerDay[index]);
+				for (int period{ 0 }; period < periodsInDay; ++period)
+				{
+					if (staffLeadTimes[index][day * periodsInDay + period])
+						flow.addEdge(dayNode, firstTime + day * periodsInDay + period, 1);
+				}
+			}
+		}
+		for (int time{ 0 }; time < numberOfTimes; ++time)
+			flow.addEdge(firstTime + time, sink, slotsAtTime[time]);
+		hallStaffSlots = flow.getMaximumFlow(source, sink);
+	}
+
+	if (activityTimes > numberOfSlots)
+		shortages.push_back("Activities must occur " + std::to_string(activityTimes) + " times but there are only " + std::to_string(numberOfSlots) + " slots");
+	if (activitySlots < numberOfSlots)
+		shortages.push_back("Activities can fill at most " + std::to_string(activitySlots) + " of the " + std::to_string(numberOfSlots) + " slots");
+	else if (hallActivitySlots < numberOfSlots) //only reported when the counts above miss it, since it then says the same thing
+		shortages.push_back("Activities can fill at most " + std::to_string(hallActivitySlots) + " of the " + std::to_string(numberOfSlots) + " slots once each is given times it can be led, since too few can be led at some of the times");
+	if (staffSlots < numberOfSlots)
+		shortages.push_back("Staff can lead at most " + std::to_string(staffSlots) + " of the " + std::to_string(numberOfSlots) + " slots");
+	else if (hallStaffSlots < numberOfSlots)
+		shortages.push_back("Staff can lead at most " + std::to_string(hallStaffSlots) + " of the " + std::to_string(numberOfSlots) + " slots once each is given times they can lead at, since too few can lead at some of the times");
+	if (minimumLoads > numberOfSlots)
+		shortages.push_back("Staff must lead at least " + std::to_string(minimumLoads) + " times between them but there are only " + std::to_string(numberOfSlots) + " slots");
+	checkLockedAssignments(scheduleSlots, activities, staff, lockedAssignments, shortages);
+
+	return shortages;
+}
+
+//the parts of a schedule one iteration of the large neighbourhood search can free
+enum class Neighbourhood
+{
+	day, //every slot on one day
+	level, //every slot of one level
+	staff, //every slot led by a few staff
+	maxNeighbourhood, //used for finding number of neighbourhoods
+};
+
+//picks the slots one iteration of the large neighbourhood search frees from a random neighbourhood
+//unfilled slots are always freed too, since filling them improves a schedule the most
+SlotMask chooseFreedSlots(const Schedule& schedule, const std::vector<Staff>& staff, std::mt19937& mt)
+{
+	constexpr int staffPerIteration{ 3 }; //number of staff whose slots are freed by the staff neighbourhood
+
+	SlotMask freed{};
+	std::uniform_int_distribution<int> neighbourhoodDistribution{ 0, static_cast<int>(Neighbourhood::maxNeighbourhood) - 1 };
+	switch (static_cast<Neighbourhood>(neighbourhoodDistribution(mt)))
+	{
+	case Neighbourhood::day:
+	{
+		int day{ std::uniform_int_distribution<int>{ 0, daysInCycle - 1 }(mt) };
+		for (int level{ 0 }; level < static_cast<int>(Level::maxLevel); ++level)
+		{
+			for (int period{ 0 }; period < periodsInDay; ++period)
+				freed.set(getSlotID(level, day * periodsInDay + period));
+		}
+		break;
+	}
+	case Neighbourhood::level:
+	{
+		int level{ std::uniform_int_distribution<int>{ 0, static_cast<int>(Level::maxLevel) - 1 }(mt) };
+		for (int time{ 0 }; time < daysInCycle * periodsInDay; ++time)
+			freed.set(getSlotID(level, time));
+		break;
+	}
+	default:
+	{
+		if (staff.empty())
+			break;
+		std::uniform_int_distribution<std::size_t> memberDistribution{ 0, staff.size() - 1 };
+		for (int count{ 0 }; count < staffPerIteration; ++count)
+		{
+			int staffID{ staff[memberDistribution(mt)].getID() };
+			for (std::size_t slotID{ 0 }; slotID < schedule.staffIDs.size(); ++slotID)
+			{
+				schedule.forEachStaff(static_cast<int>(slotID), [&freed, staffID, slotID](const int teamID)
+					{
+						if (teamID == staffID)
+							freed.set(static_cast<int>(slotID));
+					});
+			}
+		}
+		break;
+	}
+	}
+
+	for (std::size_t slotID{ 0 }; slotID < schedule.activityIDs.size(); ++slotID)
+	{
+		if (!schedule.isFilled(static_cast<int>(slotID)))
+			freed.set(static_cast<int>(slotID));
+	}
+	return freed;
+}
+
+//copies the spots of a list which can fill one of the given slots, with the times each can fill them given by ID, and prunes them to those slots
+//a spot with no times left or none of the slots could fill nothing, so it is left out of the fill rather than copied
+template <typename Spot>
+std::vector<Spot> copyFreedSpots(const std::vector<Spot>& spots, const SlotMask& slots, const std::vector<int>& times)
+{
+	std::vector<Spot> freedSpots{};
+	for (const Spot& spot : spots)
+	{
+		int timesLeft{ std::max(0, times[spot.getID()]) };
+		if (timesLeft == 0 || !spot.m_slotMask.intersects(slots))
+			continue;
+		freedSpots.push_back(spot);
+		pruneToSlots(freedSpots.back(), slots);
+		freedSpots.back().setTimesPerCycle(timesLeft);
+		freedSpots.back().setTimesLeftPerCycle(timesLeft);
+	}
+	return freedSpots;
+}
+
+//fills the given slots of a schedule with FillSpot, keeping every other assignment, with the times each activity and staff member can fill them given by ID
+//only the given slots are searched, and the kept assignments limit the activities and staff at the same times and the staff's workloads
+//only the slots and the spots which can fill them are copied, so a fill of a few slots does not copy the whole roster
+void fillSlots(Schedule& schedule, const SlotMask& slots, const std::vector<int>& times, const std::vector<ScheduleSlot>& scheduleSlots, const std::vector<Activity>& activities, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, NogoodStore& nogoods, SolveBudget& budget)
+{
+	std::vector<ScheduleSlot> freedSlots{};
+	for (const ScheduleSlot& slot : scheduleSlots)
+	{
+		if (slots.test(slot.getID()))
+			freedSlots.push_back(slot);
+	}
+
+	std::vector<Activity> freedActivities{ copyFreedSpots(activities, slots, times) };
+	std::vector<Staff> freedStaff{ copyFreedSpots(staff, slots, times) };
+
+	SymmetryClasses noClasses{}; //the schedule's classes have already been spread over their members
+	FillSpot filler(freedActivities, freedSlots, freedStaff, noClasses, nogoods);
+	filler.lockAssignments(lockedAssignments); //locked slots which were freed are locked again
+	filler.addEarlierAssignments(schedule);
+	filler.fillRemaining(budget);
+	filler.recordAssignments(schedule);
+}
+
+//adds a given change to the times left of the activity and staff filling the slot with a given ID, nothing for an unfilled slot
+void changeTimesLeft(std::vector<int>& timesLeft, const Schedule& schedule, const int slotID, const int change)
+{
+	if (!schedule.isFilled(slotID))
+		return;
+	timesLeft[schedule.activityIDs[slotID]] += change;
+	schedule.forEachStaff(slotID, [&timesLeft, change](const int staffID)
+		{
+			timesLeft[staffID] += change;
+		});
+}
+
+//gets the number of slots each activity and staff member can still fill given the slots they fill in a schedule, by ID
+//activities can fill their times per cycle and staff their maximum load, and an activity or staff member over them is left negative
+std::vector<int> getTimesLeft(const Schedule& schedule, const std::vector<Activity>& activities, const std::vector<Staff>& staff)
+{
+	std::vector<int> timesLeft(getNumberOfSpotIDs(activities, staff), 0);
+	for (const Activity& activity : activities)
+		timesLeft[activity.getID()] = activity.getTimesPerCycle();
+	for (const Staff& member : staff)
+		timesLeft[member.getID()] = member.getLimits().maximumLoad;
+	for (std::size_t slotID{ 0 }; slotID < schedule.activityIDs.size(); ++slotID)
+		changeTimesLeft(timesLeft, schedule, static_cast<int>(slotID), -1);
+	return timesLeft;
+}
+
+//the assignments of the slots a repair frees, kept so a repair which is not kept can be undone without copying the rest of the schedule
+struct FreedAssignments
+{
+	std::vector<int> slotIDs{}; //IDs of the freed slots
+	std::vector<int> activityIDs{}; //the activity which filled each freed slot
+	std::vector<int> staffIDs{}; //the lead who filled each freed slot
+	std::vector<std::vector<int>> assistantIDs{}; //the rest of the team which filled each freed slot
+	std::vector<int> fillOrder{}; //the schedule's fill order, which the repair reorders
+
+	//records the assignments of the given slots of a schedule
+	FreedAssignments(const Schedule& schedule, const SlotMask& freed)
+		: fillOrder{ schedule.fillOrder }
+	{
+		freed.forEach([this, &schedule](const int slotID)
+			{
+				slotIDs.push_back(slotID);
+				activityIDs.push_back(schedule.activityIDs[slotID]);
+				staffIDs.push_back(schedule.staffIDs[slotID]);
+				assistantIDs.push_back(schedule.assistantIDs[slotID]);
+			});
+	}
+
+	//puts the recorded assignments back into a schedule, and the times left they used back into the times left of their activities and staff
+	void restore(Schedule& schedule, std::vector<int>& timesLeft)
+	{
+		for (std::size_t index{ 0 }; index < slotIDs.size(); ++index)
+		{
+			changeTimesLeft(timesLeft, schedule, slotIDs[index], 1);
+			schedule.assign(slotIDs[index], activityIDs[index], staffIDs[index]);
+			schedule.assistantIDs[slotIDs[index]] = std::move(assistantIDs[index]);
+			changeTimesLeft(timesLeft, schedule, slotIDs[index], -1);
+		}
+		schedule.fillOrder = std::move(fillOrder);
+	}
+};
+
+//frees the given slots of a schedule and fills them again with FillSpot in place, keeping every other assignment
+//activities and staff can fill as many freed slots as they have left after the kept slots, which are kept up to date in a given list of times left by ID
+//only the freed slots are visited, searched and copied, so a repair costs about as much as the region it frees
+void refillSlots(Schedule& schedule, const SlotMask& freed, std::vector<int>& timesLeft, const std::vector<ScheduleSlot>& scheduleSlots, const std::vector<Activity>& activities, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, NogoodStore& nogoods, SolveBudget& budget)
+{
+	freed.forEach([&schedule, &timesLeft](const int slotID)
+		{
+			changeTimesLeft(timesLeft, schedule, slotID, 1);
+			schedule.assign(slotID, -1, -1);
+		});
+	std::erase_if(schedule.fillOrder, [&freed](const int slotID) //the kept decisions keep their order and the refill's follow them
+		{
+			return freed.test(slotID);
+		});
+
+	fillSlots(schedule, freed, timesLeft, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget);
+	freed.forEach([&schedule, &timesLeft](const int slotID)
+		{
+			changeTimesLeft(timesLeft, schedule, slotID, -1);
+		});
+}
+
+//frees the given slots of a copy of a schedule and fills them again with FillSpot, keeping every other assignment, returns the repaired schedule
+Schedule repairSchedule(const Schedule& schedule, const SlotMask& freed, const std::vector<ScheduleSlot>& scheduleSlots, const std::vector<Activity>& activities, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, NogoodStore& nogoods, SolveBudget& budget)
+{
+	Schedule repaired{ schedule };
+	std::vector<int> timesLeft{ getTimesLeft(repaired, activities, staff) };
+	refillSlots(repaired, freed, timesLeft, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget);
+	return repaired;
+}
+
+//improves a filled schedule with a large neighbourhood search, each iteration frees part of the schedule and refills it with FillSpot
+//a refilled schedule is kept when it scores at least as well, so the search can move between schedules of equal score
+//the schedule is repaired in place and a repair which is not kept is undone from the freed slots' old assignments, which are also all that is rescored
+//returns the number of iterations whose schedule was kept
+int improveByNeighbourhoodSearch(Schedule& schedule, const int iterations, const std::uint32_t seed, const std::vector<ScheduleSlot>& scheduleSlots, std::vector<Activity>& activities, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, NogoodStore& nogoods, SolveBudget& budget)
+{
+	std::mt19937 mt{ seed }; //merene twister, seeded so a run can be reproduced
+	ScheduleScore score{ scoreSchedule(schedule, activities) };
+	std::vector<int> timesLeft{ getTimesLeft(schedule, activities, staff) }; //kept up to date by each repair and undo
+	int kept{ 0 };
+	for (int iteration{ 0 }; iteration < iterations && !budget.isExhausted(); ++iteration)
+	{
+		SlotMask freed{ chooseFreedSlots(schedule, staff, mt) };
+		FreedAssignments old{ schedule, freed };
+		ScheduleScore repairedScore{ score };
+		for (int slotID : old.slotIDs)
+			addSlotScore(repairedScore, schedule, slotID, activities, -1);
+		refillSlots(schedule, freed, timesLeft, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget);
+		for (int slotID : old.slotIDs)
+			addSlotScore(repairedScore, schedule, slotID, activities);
+		if (score.isBetterThan(repairedScore))
+		{
+			old.restore(schedule, timesLeft);
+			continue;
+		}
+
+		score = repairedScore;
+		budget.progress.best = score;
+		++kept;
+	}
+	return kept;
+}
+
+//splits a number of times between the days in proportion to how many times each day can take, never giving a day more than it can take
+//the remainders go to the days with the largest fractions, so the shares add up to the number of times whenever the days can take them all
+std::array<int, daysInCycle> splitByDay(const int times, const std::array<int, daysInCycle>& capacity)
+{
+	std::array<int, daysInCycle> shares{};
+	int totalCapacity{ 0 };
+	for (int dayCapacity : capacity)
+		totalCapacity += dayCapacity;
+	int toSplit{ std::min(times, totalCapacity) };
+	if (toSplit <= 0)
+		return shares;
+
+	std::array<int, daysInCycle> remainders{};
+	int given{ 0 };
+	for (int day{ 0 }; day < daysInCycle; ++day)
+	{
+		shares[day] = toSplit * capacity[day] / totalCapacity;
+		remainders[day] = toSplit * capacity[day] % totalCapacity;
+		given += shares[day];
+	}
+	//a day with a remainder was given less than it can take, and there are always at least as many of them as times left
+	for (; given < toSplit; ++given)
+	{
+		int day{ static_cast<int>(std::max_element(remainders.begin(), remainders.end()) - remainders.begin()) };
+		++shares[day];
+		remainders[day] = -1;
+	}
+	return shares;
+}
+
+//fills a schedule one day at a time, with every day filled at the same time on its own thread
+//slots only interact through the activities and staff at the same time and the staff's daily limits, which never cross days,
+//so the days are only coupled by the times per cycle and maximum loads, which are split between the days before filling them
+//each day then fills its slots as the only part of the roster, after which the slots the days left unfilled are filled again
+//with whatever each activity and staff member has left over the whole cycle, which reconciles the shares with the real quotas
+//the days and the reconciling fill share the solve's budget, and each day reports its progress through it
+void fillByDay(Schedule& schedule, const std::vector<ScheduleSlot>& scheduleSlots, const std::vector<Activity>& activities, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, NogoodStore& nogoods, SolveBudget& budget)
+{
+	std::vector<std::array<int, daysInCycle>> shares(getNumberOfSpotIDs(activities, staff)); //each activity and staff member's times on each day, by ID
+
+	//locked assignments are taken out before splitting and given back to their day, so every day can still fill its locked slots
+	std::vector<std::array<int, daysInCycle>> locked(shares.size());
+	for (const LockedAssignment& assignment : lockedAssignments)
+	{
+		int day{ getSlotTime(assignment.slotID) / periodsInDay };
+		++locked[assignment.activityID][day];
+		++locked[assignment.staffID][day];
+	}
+
+	//splits a given spot's times in proportion to the times it can occur at each day, capped at a given number per day
+	auto split{ [&shares, &locked](const SpotWrapper& spot, const int times, const int dailyCap)
+		{
+			TimeSet timeSet{};
+			spot.m_slotMask.forEach([&timeSet](const int slotID)
+				{
+					timeSet.set(getSlotTime(slotID));
+				});
+			std::array<int, daysInCycle> capacity{};
+			int lockedTimes{ 0 };
+			for (int day{ 0 }; day < daysInCycle; ++day)
+			{
+				for (int period{ 0 }; period < periodsInDay; ++period)
+					capacity[day] += timeSet[day * periodsInDay + period];
+				capacity[day] = std::max(0, std::min(capacity[day], dailyCap) - locked[spot.getID()][day]);
+				lockedTimes += locked[spot.getID()][day];
+			}
+			shares[spot.getID()] = splitByDay(times - lockedTimes, capacity);
+			for (int day{ 0 }; day < daysInCycle; ++day)
+				shares[spot.getID()][day] += locked[spot.getID()][day];
+		} };
+	for (const Activity& activity : activities)
+		split(activity, activity.getTimesPerCycle(), periodsInDay);
+	for (const Staff& member : staff)
+		split(member, member.getLimits().maximumLoad, member.getLimits().dailyCap);
+
+	//every day has its own schedule, nogoods and budget so the threads share nothing they write
+	//the days run at the same time until most of the time left has passed and split most of the steps left, the rest reconciles them
+	constexpr double dayShare{ 0.8 }; //fraction of the time and steps left given to filling the days
+	std::vector<Schedule> daySchedules(daysInCycle, Schedule{ schedule.activityIDs.size() });
+	std::vector<NogoodStore> dayNogoods(daysInCycle);
+	std::vector<SolveBudget> dayBudgets{};
+	for (int day{ 0 }; day < daysInCycle; ++day)
+		dayBudgets.push_back(budget.share(daysInCycle, dayShare, day));
+	std::vector<std::exception_ptr> errors(daysInCycle); //what each day threw, rethrown once every thread has finished
+
+	auto fillDay{ [&](const int day)
+		{
+			try
+			{
+				SlotMask daySlots{};
+				for (const ScheduleSlot& slot : scheduleSlots)
+				{
+					if (slot.getTime() / periodsInDay == day)
+						daySlots.set(slot.getID());
+				}
+				std::vector<int> times(shares.size(), 0);
+				for (std::size_t spotID{ 0 }; spotID < shares.size(); ++spotID)
+					times[spotID] = shares[spotID][day];
+				fillSlots(daySchedules[day], daySlots, times, scheduleSlots, activities, staff, lockedAssignments, dayNogoods[day], dayBudgets[day]);
+			}
+			catch (...)
+			{
+				errors[day] = std::current_exception();
+			}
+		} };
+
+	std::vector<std::thread> threads{};
+	for (int day{ 1 }; day < daysInCycle; ++day)
+		threads.emplace_back(fillDay, day);
+	fillDay(0); //the first day is filled on this thread
+	for (std::thread& thread : threads)
+		thread.join();
+
+	for (const std::exception_ptr& error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+
+	//joins the days, each of which only filled its own slots
+	SlotMask unfilled{};
+	for (const ScheduleSlot& slot : scheduleSlots)
+	{
+		const Schedule& daySchedule{ daySchedules[slot.getTime() / periodsInDay] };
+		if (daySchedule.isFilled(slot.getID()))
+		{
+			schedule.assign(slot.getID(), daySchedule.activityIDs[slot.getID()], daySchedule.staffIDs[slot.getID()]);
+			schedule.assistantIDs[slot.getID()] = daySchedule.assistantIDs[slot.getID()];
+		}
+		else
+			unfilled.set(slot.getID());
+	}
+	for (const Schedule& daySchedule : daySchedules) //the days' decisions are ordered day by day
+		schedule.fillOrder.insert(schedule.fillOrder.end(), daySchedule.fillOrder.begin(), daySchedule.fillOrder.end());
+	for (const SolveBudget& dayBudget : dayBudgets)
+		budget.add(dayBudget);
+
+	//reconciles the shares with the quotas by filling the slots left unfilled with every time left over from any day
+	schedule = repairSchedule(schedule, unfilled, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget);
+}
+
+//hashes a list of ints into a given hash, followed by its length so that the lists hashed one after another cannot run into each other
+std::uint64_t hashInts(const std::vector<int>& ints, const std::uint64_t hash)
+{
+	std::uint64_t length{ ints.size() };
+	std::uint64_t hashed{ hashBytes({ reinterpret_cast<const char*>(ints.data()), ints.size() * sizeof(int) }, hash) };
+	return hashBytes({ reinterpret_cast<const char*>(&length), sizeof(length) }, hashed);
+}
+
+//hashes the flat assignment arrays of a schedule, so a candidate which repeats a schedule already found is skipped without comparing it to each one
+std::uint64_t hashSchedule(const Schedule& schedule)
+{
+	std::uint64_t hash{ hashInts(schedule.staffIDs, hashInts(schedule.activityIDs, hashBytes({}))) };
+	for (const std::vector<int>& assistants : schedule.assistantIDs)
+		hash = hashInts(assistants, hash);
+	return hash;
+}
+
+//gets the Hamming distance between two schedules, the number of slots whose activity or team differ
+int getScheduleDistance(const Schedule& schedule1, const Schedule& schedule2)
+{
+	int distance{ 0 };
+	for (std::size_t slotID{ 0 }; slotID < schedule1.activityIDs.size(); ++slotID)
+	{
+		if (schedule1.activityIDs[slotID] != schedule2.activityIDs[slotID] || schedule1.staffIDs[slotID] != schedule2.staffIDs[slotID] || schedule1.assistantIDs[slotID] != schedule2.assistantIDs[slotID])
+			++distance;
+	}
+	return distance;
+}
+
+//finds up to a given number of the best schedules which each differ from every better one in at least a given number of slots, starting from a solved schedule
+//each candidate branches from one found before it: it keeps a prefix of that schedule's fill order and refills the rest, with the decision it branches at
+//forbidden by a nogood so the refill goes another way, so the decisions kept are never searched again and only the suffix costs a fill
+//that nogood is added to the solve's nogoods for the refill and taken away after it, so no branch copies the nogoods
+//the pool is then picked from the distinct candidates greedily, best first
+std::vector<Schedule> findSchedulePool(const Schedule& solved, const int size, const int minimumDistance, const std::uint32_t seed, const std::vector<ScheduleSlot>& scheduleSlots, std::vector<Activity>& activities, const std::vector<Staff>& staff, const std::vector<LockedAssignment>& lockedAssignments, NogoodStore& nogoods, SolveBudget& budget)
+{
+	constexpr int branchesPerSchedule{ 8 }; //candidates tried for each schedule the pool should hold
+
+	std::mt19937 mt{ seed }; //merene twister, seeded so a run can be reproduced
+	std::vector<Schedule> candidates{ solved };
+	std::vector<ScheduleScore> scores{ scoreSchedule(solved, activities) };
+	std::unordered_set<std::uint64_t> seen{ hashSchedule(solved) }; //hashes of the candidates, so a branch which finds one again is dropped
+	for (int attempt{ 0 }; attempt < size * branchesPerSchedule && !budget.isExhausted(); ++attempt)
+	{
+		const Schedule& parent{ candidates[std::uniform_int_distribution<std::size_t>{ 0, candidates.size() - 1 }(mt)] };
+		const std::vector<int>& order{ parent.fillOrder };
+		if (order.empty())
+			continue;
+
+		//branches far enough back that the refilled decisions can reach the minimum distance
+		int lastBranch{ std::clamp(static_cast<int>(order.size()) - minimumDistance, 0, static_cast<int>(order.size()) - 1) };
+		int branch{ std::uniform_int_distribution<int>{ 0, lastBranch }(mt) };
+		SlotMask freed{};
+		for (std::size_t index{ static_cast<std::size_t>(branch) }; index < order.size(); ++index)
+			freed.set(order[index]);
+		for (std::size_t slotID{ 0 }; slotID < parent.activityIDs.size(); ++slotID) //unfilled slots are refilled too, so the branch can fill them
+		{
+			if (!parent.isFilled(static_cast<int>(slotID)))
+				freed.set(static_cast<int>(slotID));
+		}
+
+		//the parent's decision is only forbidden in this branch, so it and whatever the branch learns are taken away after its refill
+		int slotID{ order[branch] };
+		std::size_t sharedNogoods{ nogoods.size() };
+		nogoods.add(slotID, { NogoodStore::getLiteral(slotID, parent.activityIDs[slotID], parent.staffIDs[slotID]) });
+		Schedule candidate{ repairSchedule(parent, freed, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget) };
+		nogoods.truncate(sharedNogoods);
+		if (!seen.insert(hashSchedule(candidate)).second)
+			continue;
+		scores.push_back(scoreSchedule(candidate, activities));
+		candidates.push_back(std::move(candidate));
+	}
+
+	std::vector<std::size_t> ranked(candidates.size()); //the indices of the candidates from best to worst
+	for (std::size_t index{ 0 }; index < ranked.size(); ++index)
+		ranked[index] = index;
+	std::stable_sort(ranked.begin(), ranked.end(), [&scores](const std::size_t index1, const std::size_t index2)
+		{
+			return scores[index1].isBetterThan(scores[index2]);
+		});
+
+	std::vector<Schedule> pool{};
+	for (std::size_t index : ranked)
+	{
+		if (static_cast<int>(pool.size()) == size)
+			break;
+		if (std::all_of(pool.begin(), pool.end(), [&candidates, index, minimumDistance](const Schedule& kept) { return getScheduleDistance(kept, candidates[index]) >= minimumDistance; }))
+			pool.push_back(std::move(candidates[index]));
+	}
+	return pool;
+}
+
+//a what-if version of a loaded roster, made of the roster shared by every scenario and the changes made to it
+//the changes form a persistent list which a fork shares with the scenario it was forked from, so a fork costs only the changes made to it
+//the roster is only copied, with the changes applied, by the solve which needs its own spots to fill
+class Scenario
+{
+	//a change which stops a spot from filling the slots at some times
+	struct Change
+	{
+		int spotID{}; //ID of the activity or staff member changed
+		TimeSet removedTimes{}; //times at which the spot can no longer fill slots
+		bool removesSpot{ false }; //stores whether the spot is taken out of the roster, so it no longer needs to fill any slots either
+		std::shared_ptr<const Change> previous{}; //the change made before this one, shared with every fork made after it
+	};
+
+	std::shared_ptr<const LoadedRoster> m_roster{}; //the roster every scenario forked from the same roster shares
+	std::shared_ptr<const Change> m_lastChange{}; //the most recent change, nullptr for the roster as it was read in
+	std::uint64_t m_inputFingerprint{}; //the roster's fingerprint with every change hashed into it
+
+	//adds a change stopping the spot with a given ID filling slots at the given times, described by a given text for the fingerprint
+	void addChange(const int spotID, const TimeSet& removedTimes, std::string_view description, const bool removesSpot = false)
+	{
+		m_lastChange = std::make_shared<const Change>(Change{ spotID, removedTimes, removesSpot, m_lastChange });
+		m_inputFingerprint = hashBytes(description, m_inputFingerprint);
+	}
 
-		for (Staff& staff : m_staff) //adds pointers to all scheduleSlots to spotsToBeFilled
-		{
-			m_spotsToBeFilled.push_back(&staff);
-		}
+public:
 
-		updateSpotsToBeFilled(); //updates the spots to be filled list and its members indices
+	//creates the scenario of a roster with no changes, given the fingerprint of the roster's input
+	Scenario(std::shared_ptr<const LoadedRoster> roster, const std::uint64_t inputFingerprint)
+		: m_roster{ std::move(roster) },
+		m_inputFingerprint{ inputFingerprint }
+	{
+	}
 
+	//copies this scenario to make changes to without changing this one, the roster and changes so far are shared rather than copied
+	Scenario fork() const
+	{
+		return *this;
 	}
 
-	//fills the next spot in the lsit and updates all spots as needed
-	SpotWrapper* fillNextSpot()
+	//stops the activity with a given ID from occuring on a given day, counted from 0
+	void dropActivity(const int activityID, const int day)
 	{
+		TimeSet times{};
+		for (int period{ 0 }; period < periodsInDay; ++period)
+			times.set(day * periodsInDay + period);
+		addChange(activityID, times, "drop " + std::to_string(activityID) + ' ' + std::to_string(day));
+	}
 
-		SpotWrapper* item1{ m_spotsToBeFilled[0] }; //gets the first spot as the first spot in the spots to be filled list
+	//stops the staff member with a given ID from leading slots outside the given times
+	void restrictStaff(const int staffID, const TimeSet& availableTimes)
+	{
+		addChange(staffID, ~availableTimes, "only " + std::to_string(staffID) + ' ' + availableTimes.to_string());
+	}
 
-		SpotWrapper* item2{ nullptr };
+	//takes the activity or staff member with a given ID out of the roster, along with any locked assignments using them
+	void removeSpot(const int spotID)
+	{
+		addChange(spotID, TimeSet{}.set(), "remove " + std::to_string(spotID), true);
+	}
 
+	//gets the roster this scenario was forked from
+	const LoadedRoster& getRoster() const
+	{
+		return *m_roster;
+	}
 
+	//gets the fingerprint of this scenario's input, the roster's fingerprint with every change hashed into it
+	std::uint64_t getInputFingerprint() const
+	{
+		return m_inputFingerprint;
+	}
 
+	//copies the roster and applies this scenario's changes to the copy, oldest first, for a solve to fill
+	LoadedRoster apply() const
+	{
+		LoadedRoster roster{ *m_roster };
+		SpotTable spots{ roster.scheduleSlots, roster.activities, roster.staff };
 
-		SpotWrapper* item3{ nullptr };
+		std::vector<const Change*> changes{};
+		for (const Change* change{ m_lastChange.get() }; change != nullptr; change = change->previous.get())
+			changes.push_back(change);
 
-		//gets the third spot as the first spot from the union of the first and second spot
-		while (item3 == nullptr) //while there is no common item bwtween item 1 and 2
+		for (auto change{ changes.rbegin() }; change != changes.rend(); ++change)
 		{
+			SpotWrapper* spot{ spots.get(SpotId<SpotWrapper>{ (*change)->spotID }) };
+			if (spot == nullptr || spot->getType() == SpotWrapper::Type::ScheduleSlot)
+				throw "Scenario changes an unknown activity or staff\n";
 
-			try
+			//the slots are found first since removing a slot reorders the list being searched
+			std::vector<SlotId> removed{};
+			for (SlotId slot : spot->getTimesAvailable())
 			{
-				item2 = getNext(item1); //gets the second spot as the first spot's next spot
+				if ((*change)->removedTimes.test(getSlotTime(slot.get())))
+					removed.push_back(slot);
 			}
-			catch (...)
+			for (SlotId slotID : removed)
 			{
-				return item1; //if nothing can fill the spots return the first spot
+				ScheduleSlot* slot{ spots.get(slotID) };
+				slot->remove(spot);
+				spot->remove(slot);
 			}
-			//gets the third spot as the first spot from the union of the first and second spot
-			item3 = getFirst(item1, item2);
-		}
-
-		item1->add(item2, item3); //adds the second and third spot to the first one and removes the first spot from the possible lists of the second and third spots if necessary
-		item2->add(item1, item3); //adds the first and third spot to the second one and removes the second spot from the possible lists of the first and third spots if necessary
-		item3->add(item1, item2); //adds the first and second spot to the third one and removes the third spot from the possible lists of the first and second spots if necessary
-
-		updateSpotsToBeFilled(); //updates the spots to be filled list and its members indices
 
-		return nullptr;
-	}
-
-	//adds 1 times to fill and times left to fill to slot with given id
-	void addToSlot(int id)
-	{
-		//finds spot with given id
-		auto found{ std::find(m_spotsToBeFilled.begin(), m_spotsToBeFilled.end(), [id](SpotWrapper* spot)
-		{
-		 if (spot->getID() == id)
-		  return true;
-		 return false;
-		}) };
-		//increments times to fill and times left to fill
-		(*found)->incrementTimesPerCycle();
-		(*found)->incrementTimesLeftPerCycle();
+			if ((*change)->removesSpot) //the spot no longer needs to occur or lead, so it is completed before the solve starts
+			{
+				spot->setTimesPerCycle(0);
+				spot->setTimesLeftPerCycle(0);
+				spot->m_completed = true;
+				spot->updateSortKey();
+				if (spot->getType() == SpotWrapper::Type::Staff)
+					static_cast<Staff*>(spot)->setLimits({ 0, 0 });
+				std::erase_if(roster.lockedAssignments, [spot](const LockedAssignment& locked)
+					{
+						return locked.activityID == spot->getID() || locked.staffID == spot->getID();
+					});
+			}
+		}
+		return roster;
 	}
 };
 
+//solves a given copy of a loaded roster, whose input has a given fingerprint, the copy is changed by the solve
+//every piece of solver state belongs to this call, so any number of rosters can be solved at the same time
+SolvedSchedule solveLoadedRoster(LoadedRoster& loaded, const std::uint64_t inputFingerprint, const std::uint32_t seed, const SolverOptions& options)
+{
+	auto& [scheduleSlots, activities, staff, lockedAssignments] { loaded };
+
+	reportShortages(checkFeasibility(scheduleSlots, activities, staff, lockedAssignments)); //stops before solving when the roster cannot be scheduled
 
+	//groups interchangeable activities and staff so the search only tries one of each group
+	//the days are filled without classes, since each day would spread its classes over their members differently
+	SymmetryClasses classes{ options.symmetry && !options.byDay ? findSymmetryClasses(activities, staff) : SymmetryClasses{} };
+	NogoodStore nogoods{}; //shared by every fill of this roster so what one fill learns prunes the retries and repairs after it
 
+	Schedule schedule{ scheduleSlots.size() }; //holds the activity and staff filling each slot once the participant groups are filled
 
+	//bounds the solve by the time and iteration limits, the schedule filled so far is returned once either is reached
+	SolveBudget budget{ options.timeLimit, options.iterationLimit, options.progress ? std::function<void(const SolveProgress&)>{ writeProgress } : nullptr };
 
+	if (options.byDay) //fills each day on its own thread instead of blocks of slots with the same number of participants
+	{
+		fillByDay(schedule, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget);
+		budget.progress.best = scoreSchedule(schedule, activities);
+	}
+	else
+	{
+		//sorts scheduleSlots by most participants
+		std::sort(scheduleSlots.begin(), scheduleSlots.end(), [](ScheduleSlot& first, ScheduleSlot& second)
+			{
+				return first.getNumberOfParticipants() > second.getNumberOfParticipants();
+			});
 
+		std::vector <ScheduleSlot*> startOfBlocks{ &scheduleSlots[0] }; //holds the starting slot of each block of schedule slots with same number of participants
+		std::vector <ParticipantGroup> participantGroups{}; //holds all blocks
 
+		//loop through sorted list of schedule slots
+		for (auto& endOfBlock : scheduleSlots)
+		{
+			//starts new block when number of participants change
+			if (endOfBlock.getNumberOfParticipants() != startOfBlocks[startOfBlocks.size() - 1]->getNumberOfParticipants())
+				startOfBlocks.push_back(& endOfBlock);
+		}
+		startOfBlocks.push_back(scheduleSlots.data() + scheduleSlots.size()); //the end of the roster ends the last block, so it is filled like the others
 
+		int unfilledSlots{ 0 };
 
+		//holds order of activities and staff to be filled
+		std::vector <ActivityId> activitiesToFill{};
+		std::vector <StaffId> staffToFill{};
 
+		//fills activity as staff fill lists, without the times taken by locked assignments
+		std::vector<int> locked(getNumberOfSpotIDs(activities, staff), 0);
+		for (const LockedAssignment& assignment : lockedAssignments)
+		{
+			++locked[static_cast<std::size_t>(assignment.activityID)];
+			++locked[static_cast<std::size_t>(assignment.staffID)];
+		}
+		fillFillList(activitiesToFill, activities, scheduleSlots.size(), locked);
+		fillFillList(staffToFill, staff, scheduleSlots.size(), locked);
 
+		//creates participant group blocks and adds them to list
+		for (std::size_t index{ 1 }; index < startOfBlocks.size(); ++index)
+		{
+			participantGroups.emplace_back( ParticipantGroup(startOfBlocks[index - 1] - unfilledSlots, startOfBlocks[index] - 1, activities, staff,startOfBlocks[index - 1] - unfilledSlots - startOfBlocks[0], activitiesToFill, staffToFill, lockedAssignments, schedule, options, classes, nogoods, budget) );
+			//updates number of unfilled spots
+			unfilledSlots = participantGroups[participantGroups.size() - 1].getUnfilledSlots();
+			budget.progress.best = scoreSchedule(schedule, activities); //a single pass only improves the schedule so the latest is the best
+		}
 
+		expandSymmetryClasses(schedule, classes, staff, lockedAssignments); //spreads the slots of each class over its members
+	}
 
+	if (options.neighbourhoodIterations > 0) //improves the filled schedule by repeatedly freeing and refilling part of it
+		improveByNeighbourhoodSearch(schedule, options.neighbourhoodIterations, seed, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget);
 
+	SolvedSchedule snapshot{};
+	if (options.poolSize > 1) //finds alternatives for the director to choose between, a branch can beat the schedule it started from so the best is kept as the solved schedule
+	{
+		std::vector<Schedule> pool{ findSchedulePool(schedule, options.poolSize, options.poolDistance, seed, scheduleSlots, activities, staff, lockedAssignments, nogoods, budget) };
+		schedule = std::move(pool[0]);
+		for (std::size_t index{ 1 }; index < pool.size(); ++index)
+		{
+			snapshot.alternativeScores.push_back(scoreSchedule(pool[index], activities));
+			snapshot.alternatives.push_back(std::move(pool[index]));
+		}
+	}
 
+	//copies the rooms and participants of each slot by ID since the slots were sorted
+	snapshot.roomIDs.assign(scheduleSlots.size(), -1);
+	snapshot.participants.assign(scheduleSlots.size(), 0);
+	std::vector<const Room*> rooms{}; //rooms already added to the room names, in the same order
+	for (const ScheduleSlot& slot : scheduleSlots)
+	{
+		snapshot.participants[slot.getID()] = slot.getNumberOfParticipants();
+		if (slot.getRoom() == nullptr)
+			continue;
+		auto room{ std::find(rooms.begin(), rooms.end(), slot.getRoom()) };
+		if (room == rooms.end())
+		{
+			rooms.push_back(slot.getRoom());
+			snapshot.roomNames.push_back(slot.getRoom()->name);
+			room = rooms.end() - 1;
+		}
+		snapshot.roomIDs[slot.getID()] = static_cast<int>(room - rooms.begin());
+	}
 
+	snapshot.unfilledSlots = static_cast<int>(std::count(schedule.activityIDs.begin(), schedule.activityIDs.end(), -1));
+	snapshot.schedule = std::move(schedule);
+	snapshot.names = getSpotNames(activities, staff);
+	snapshot.firstStaffID = staff.empty() ? 0 : staff[0].getID();
+	snapshot.numberOfStaff = static_cast<int>(staff.size());
+	snapshot.run = { seed, getRunFingerprint(inputFingerprint, seed, options) }; //identifies this run in every output so that it can be reproduced
+	snapshot.score = scoreSchedule(snapshot.schedule, activities);
+	snapshot.budgetExhausted = budget.isExhausted();
+
+	budget.progress.best = snapshot.score;
+	budget.report(); //the last progress event always has the final score
+	return snapshot;
+}
 
-class ParticipantGroup
+//reads in and solves a given roster
+SolvedSchedule solveRoster(const Roster& roster, const std::uint32_t seed, const SolverOptions& options)
 {
-	int m_participants{}; //holds number of participants in group
-	std::vector <ScheduleSlot> m_scheduleSlots{}; //holds scheduleSlots in group
-	std::vector <Activity> m_activities{}; //holds activities in group
-	std::vector <Staff> m_staff{}; //holds staff in group
-	int m_totalTimeSlots{};
-	int m_startOfListID{}; //holds ID of first slot read in
-	int m_endOfListID{};
-	int m_unfilledSlots{};
-	SpotWrapper* m_startOfListPointer{};
+	LoadedRoster loaded{ loadRoster(roster) };
+	return solveLoadedRoster(loaded, getInputFingerprint(roster), seed, options);
+}
 
-	//Removes all out of scope schedule slots from this spot's possible list and reassigns pointers to this group's copy
-	void prunePossibleSlots(SpotWrapper& spot)
+//runs submitted jobs on a fixed number of threads
+class WorkerPool
+{
+	std::vector<std::thread> m_threads{}; //threads running jobs
+	std::deque<std::function<void()>> m_jobs{}; //jobs waiting for a free thread
+	std::mutex m_mutex{}; //guards the job queue
+	std::condition_variable m_jobAdded{}; //wakes threads when a job is added or the pool is stopping
+	bool m_stopping{ false }; //stores whether the pool is being destroyed
+
+	//runs jobs until the pool is stopping and no jobs are left
+	void work()
 	{
-		std::size_t index{ 0 }; //keeps track of spot's possible slots we are iterating through
-		std::vector <ScheduleSlot*>* possibleSlots{ &spot.getTimesAvailable() }; //a modifiable list of this spot's possible slots
-		while (index < possibleSlots->size()) //while there are more spots to check
+		while (true)
 		{
-			int indexID{ (*possibleSlots)[index]->getID() };
-
-			//if the id of the slot is outside the slots used by this participant group, remove it from the list
-			if (indexID<m_startOfListID || indexID>m_endOfListID)
-				possibleSlots[index].erase(possibleSlots->begin() + index);
-
-			//otherwise replace it with a reference to the copy
-			else
+			std::function<void()> job{};
 			{
-				(*possibleSlots)[index] = &(m_scheduleSlots[(*possibleSlots)[index]->getID() - m_startOfListID]);
-				++index;
+				std::unique_lock lock{ m_mutex };
+				m_jobAdded.wait(lock, [this] { return m_stopping || !m_jobs.empty(); });
+				if (m_jobs.empty())
+					return;
+				job = std::move(m_jobs.front());
+				m_jobs.pop_front();
 			}
+			job();
 		}
 	}
 
-	//reseats all pointers in given list to their local copy
-	template <typename T>
-	void reseatPointers(std::vector<T*>* spots, std::vector<T> newSpots)
+public:
+
+	//starts the given number of threads
+	explicit WorkerPool(const unsigned int workers)
 	{
-		for (SpotWrapper* spot : *spots)
-			spot = newSpots[spot->getID() - newSpots[0]->getID()];
+		for (unsigned int index{ 0 }; index < workers; ++index)
+			m_threads.emplace_back(&WorkerPool::work, this);
 	}
 
-	//preforms prune actions on activity's possible pointers
-	void pruneActivities(std::vector <Activity*>& activitiesToFill)
+	//finishes all submitted jobs before stopping the threads
+	~WorkerPool()
 	{
-		for (Activity& activity : m_activities) //for each activity
 		{
-			//resets times per cycle and times left per cycle
-			activity.setTimesPerCycle( 0 );
-			activity.setTimesLeftPerCycle( 0 );
-
-			prunePossibleSlots(activity);
-			//reseat possible staff vectors
-
-			std::vector <Staff*>* preferredStaff{ &activity.getPreferredStaff() }; //a modifiable list of this activity's preferred staff
-			//reassigns all preferred staff for this activitiy and reassigns them to copies in this object
-			reseatPointers(preferredStaff, m_staff);
-
-			std::vector <Staff*>* neutralStaff{ &activity.getNeutralStaff() }; //a modifiable list of this activity's neutral staff
-			//reassigns all neutral staff for this activitiy and reassigns them to copies in this object
-			reseatPointers(neutralStaff, m_staff);
-
-			std::vector <Staff*>* unpreferredStaff{ &activity.getUnpreferredStaff() }; //a modifiable list of this activity's unpreferred staff
-			//reassigns all unpreferred staff for this activitiy and reassigns them to copies in this object
-			reseatPointers(unpreferredStaff, m_staff);
+			std::scoped_lock lock{ m_mutex };
+			m_stopping = true;
 		}
+		m_jobAdded.notify_all();
+		for (std::thread& thread : m_threads)
+			thread.join();
+	}
 
-		//increment each copy of activity corresponding with list to fill to get proper spots to fill for each activity
-		for (std::size_t index{ 0 }; index < m_scheduleSlots.size(); ++index)
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	//adds a job to be run on the next free thread
+	void submit(std::function<void()> job)
+	{
 		{
-			m_activities[activitiesToFill[index]->getID() - m_activities[0].getID()].incrementTimesPerCycle();
-			m_activities[activitiesToFill[index]->getID() - m_activities[0].getID()].incrementTimesLeftPerCycle();
+			std::scoped_lock lock{ m_mutex };
+			m_jobs.push_back(std::move(job));
 		}
+		m_jobAdded.notify_one();
 	}
+};
 
-	//preforms prune actions on staff's possible pointers
-	void pruneStaff(std::vector <Staff*>& staffToFill)
+//a roster the server has been given, read in once when it is given so requests and solves never read it again
+struct ServerRoster
+{
+	Roster roster{}; //the roster's text, which LOCK and UNLOCK change
+	LoadedRoster loaded{}; //the roster's spots, which each solve copies
+	std::uint64_t inputFingerprint{}; //the fingerprint of the roster's text
+	std::vector<std::string> shortages{}; //what checking the roster found before solving, answered by CHECK
+
+	ServerRoster() = default;
+
+	//reads in and checks a given roster, throws the reader's error if it cannot be read
+	explicit ServerRoster(Roster text)
+		: roster{ std::move(text) },
+		loaded{ loadRoster(roster) },
+		inputFingerprint{ getInputFingerprint(roster) }
 	{
-		for (Staff& staff : m_staff) //for each staff
-		{
-			//resets times per cycle and times left per cycle
-			staff.setTimesPerCycle( 0 );
-			staff.setTimesLeftPerCycle( 0 );
+		LoadedRoster checked{ loaded }; //checkFeasibility reads the spots through their non const getters
+		shortages = checkFeasibility(checked.scheduleSlots, checked.activities, checked.staff, checked.lockedAssignments);
+	}
+
+	//returns whether a roster has been given
+	bool isLoaded() const
+	{
+		return !roster.scheduling.empty();
+	}
+};
+
+//keeps a roster in memory and answers requests about it over a local socket, one request per line:
+//LOAD <scheduling csv> [locked csv], LOCK <day>,<period>,<level>,<activity>,<staff>, UNLOCK, SOLVE [seed], STATUS, STAFF <name>, CHECK, QUIT, STOP
+class SchedulingServer
+{
+	//a connected client, answered on its own thread so queries never wait for a solve
+	struct Client
+	{
+		int socket{}; //the client's socket, closed once its thread has been joined so a shutdown never reaches a reused socket
+		std::atomic<bool> done{ false }; //set by the client's thread once it has stopped answering
+		std::thread thread{}; //the thread answering the client
+	};
 
-			prunePossibleSlots(staff);
+	static constexpr int acceptInterval{ 200 }; //milliseconds the accept loop waits for a client before checking whether it should stop
 
-			//reseat possible activity vectors
+	//the roster and latest schedule are never modified, only replaced by atomically swapping the pointer to them
+	//so readers always see a whole roster or schedule and never wait on the solver, and old copies are freed once their last reader is done
+	std::atomic<std::shared_ptr<const ServerRoster>> m_roster{ std::make_shared<const ServerRoster>() }; //current roster, solves keep reading the roster they started with
+	std::atomic<std::shared_ptr<const SolvedSchedule>> m_latest{}; //latest solved schedule, nullptr until something is solved
+	std::atomic<std::uint64_t> m_solveNumber{ 0 }; //the number of the last solve requested
+	std::atomic<bool> m_stopping{ false }; //set by STOP or stop(), the server then stops accepting clients and serve returns once every client has been let go
+	std::list<Client> m_clients{}; //the clients connected, only used by the thread running serve
+	SolverOptions m_options{}; //options of every solve, its seed is used by solves which are not given one
+	WorkerPool m_pool; //runs solves so requests can be answered while solving
 
-			std::vector <Activity*>* preferredActivities{ &staff.getPreferredActivities() }; //a modifiable list of this activity's preferred staff
-			//reassigns all preferred activities for this staff member and reassigns them to copies in this object
-			reseatPointers(preferredActivities, m_activities);
+	//gets the current roster
+	std::shared_ptr<const ServerRoster> getRoster() const
+	{
+		return m_roster.load();
+	}
 
-			std::vector <Activity*>* neutralActivities{ &staff.getNeutralActivities() }; //a modifiable list of this activity's neutral staff
-			//reassigns all neutral activities for this staff member and reassigns them to copies in this object
-			reseatPointers(neutralActivities, m_activities);
+	//gets the latest solved schedule, nullptr if nothing has been solved yet
+	std::shared_ptr<const SolvedSchedule> getLatest() const
+	{
+		return m_latest.load();
+	}
 
-			std::vector <Activity*>* unpreferredActivities{ &staff.getUnpreferredActivities() }; //a modifiable list of this activity's unpreferred staff
-			//reassigns all unpreferred activities for this staff member and reassigns them to copies in this object
-			reseatPointers(unpreferredActivities, m_activities);
+	//reads in a roster and makes it the current roster, returns the response to the request which changed it
+	//a roster which cannot be read is not kept, so the current roster is always one which was read in
+	std::string setRoster(Roster roster)
+	{
+		try
+		{
+			m_roster.store(std::make_shared<const ServerRoster>(std::move(roster)));
 		}
-		//increment each copy of staff corresponding with list to fill to get proper spots to fill for each activity
-		for (std::size_t index{ 0 }; index < m_scheduleSlots.size(); ++index)
+		catch (const char* errorMessage)
 		{
-			m_staff[staffToFill[index]->getID() - m_staff[0].getID()].incrementTimesPerCycle();
-			m_staff[staffToFill[index]->getID() - m_staff[0].getID()].incrementTimesLeftPerCycle();
+			std::string response{ "ERROR " };
+			response += errorMessage;
+			if (response.back() != '\n')
+				response += '\n';
+			return response;
 		}
+		return "OK\n";
 	}
 
-	//reseats pointers to copy lists for activity and staff lists in each schedule slot copy
-	void pruneScheduleSlots()
+	//replaces the latest schedule unless a more recently requested solve has already been published
+	void publish(std::shared_ptr<const SolvedSchedule> snapshot)
 	{
-		//for each slot
-		for (ScheduleSlot& slot : m_scheduleSlots)
+		std::shared_ptr<const SolvedSchedule> latest{ m_latest.load() };
+		do
 		{
-		 std::vector <Activity*>* possibleActivities{&slot.getActivitiesAvailable()}; //a modifiable list of this slot's possible activities
-		 std::vector <Staff*>* possibleStaff{&slot.getStaffAvailable()}; //a modifiable list of this slot's possible staff
+			if (latest && latest->solveNumber > snapshot->solveNumber)
+				return;
+		} while (!m_latest.compare_exchange_weak(latest, snapshot)); //latest is reloaded when another solve published first
+	}
 
-		 //reassigns all possible activities in this slot and reassigns them to copies in this object
-		 reseatPointers(possibleActivities, m_activities);
-		 //reassigns all possible staff in this slot and reassigns them to copies in this object
-		 reseatPointers(possibleStaff, m_staff);
-		}
+	//queues a solve of the current roster, returns its number
+	std::uint64_t queueSolve(const std::uint32_t seed)
+	{
+		std::shared_ptr<const ServerRoster> roster{ getRoster() };
+		std::uint64_t number{ ++m_solveNumber };
+
+		m_pool.submit([this, roster, seed, number]
+			{
+				try
+				{
+					LoadedRoster loaded{ roster->loaded }; //the solve changes its own copy of the spots read in when the roster was given
+					auto snapshot{ std::make_shared<SolvedSchedule>(solveLoadedRoster(loaded, roster->inputFingerprint, seed, m_options)) };
+					snapshot->solveNumber = number;
+					publish(std::move(snapshot));
+				}
+				catch (const char* errorMessage)
+				{
+					std::cerr << errorMessage;
+				}
+				catch (...)
+				{
+					std::cerr << "Solve " << number << " failed\n";
+				}
+			});
+		return number;
 	}
 
-		//fills participant group
-		void fill(std::vector <Activity*>& activitiesToFill, std::vector <Staff*>& staffToFill)
+	//gets the timetable of the staff member with the given name from the latest schedule
+	std::string getStaffTimetable(std::string_view name)
 	{
-		int numberOfScheduleSlots{ m_scheduleSlots.size() }; //holds number if schedule slots
-		FillSpot filler(m_activities, m_scheduleSlots, m_staff); //initialize fillspot
-		//fill each slot in list
+		std::shared_ptr<const SolvedSchedule> snapshot{ getLatest() };
+		if (!snapshot)
+			return "ERROR nothing has been solved\n";
 
-		SpotWrapper* unfillable{ nullptr };
-		int swapIndex{ 0 };
-		for (std::size_t index{ 0 }; index < numberOfScheduleSlots; ++index)
+		for (int staffIndex{ 0 }; staffIndex < snapshot->numberOfStaff; ++staffIndex)
 		{
-			unfillable = { filler.fillNextSpot() };
-			//if the spot to be added cannot be added
-			if (unfillable != nullptr)
+			if (snapshot->names[snapshot->firstStaffID + staffIndex] != name)
+				continue;
+
+			std::string response{};
+			const Schedule& schedule{ snapshot->schedule };
+			for (int slotID{ 0 }; slotID < static_cast<int>(schedule.staffIDs.size()); ++slotID)
 			{
-				//remove 1 from times per cycle of unfillable index
-				unfillable->setTimesPerCycle(unfillable->getTimesPerCycle() - 1);
-				unfillable->setTimesLeftPerCycle(unfillable->getTimesPerCycle() - 1);
+				bool onTeam{ false }; //whether the staff member leads or assists the slot
+				schedule.forEachStaff(slotID, [&onTeam, &snapshot, staffIndex](const int staffID)
+					{
+						onTeam = onTeam || staffID == snapshot->firstStaffID + staffIndex;
+					});
+				if (!onTeam)
+					continue;
+				appendSlotColumns(response, slotID);
+				response += ',';
+				response += snapshot->names[schedule.activityIDs[slotID]];
+				response += '\n';
+			}
+			return response + "END\n";
+		}
+		return "ERROR unknown staff\n";
+	}
 
-				//if spot is activity
-				if (unfillable->getType() == SpotWrapper::Type::Activity)
+	//answers a single request
+	std::string handle(std::string_view request)
+	{
+		std::size_t space{ request.find(' ') };
+		std::string_view command{ request.substr(0, space) };
+		std::string_view argument{ space == std::string_view::npos ? std::string_view{} : request.substr(space + 1) };
+
+		if (command == "LOAD")
+		{
+			std::size_t split{ argument.find(' ') };
+			Roster roster{};
+			roster.scheduling = readFile(std::string{ argument.substr(0, split) });
+			if (split != std::string_view::npos)
+				roster.locked = readFile(std::string{ argument.substr(split + 1) });
+			if (roster.scheduling.empty())
+				return "ERROR file could not be opened\n";
+			return setRoster(std::move(roster));
+		}
+		if (command == "LOCK")
+		{
+			Roster roster{ getRoster()->roster };
+			if (roster.scheduling.empty())
+				return "ERROR nothing has been loaded\n";
+			if (roster.locked.empty())
+				roster.locked = "Day,Period,Level,Activity,Staff\n"; //the locked assignments reader skips the column headers
+			roster.locked += argument;
+			roster.locked += '\n';
+			return setRoster(std::move(roster));
+		}
+		if (command == "UNLOCK")
+		{
+			Roster roster{ getRoster()->roster };
+			if (roster.scheduling.empty())
+				return "ERROR nothing has been loaded\n";
+			roster.locked.clear();
+			return setRoster(std::move(roster));
+		}
+		if (command == "SOLVE")
+		{
+			if (!getRoster()->isLoaded())
+				return "ERROR nothing has been loaded\n";
+			std::uint32_t seed{ argument.empty() ? m_options.seed.value_or(std::random_device{}()) : static_cast<std::uint32_t>(std::stoul(std::string{ argument })) };
+			return "QUEUED " + std::to_string(queueSolve(seed)) + '\n';
+		}
+		if (command == "STATUS")
+		{
+			std::shared_ptr<const SolvedSchedule> snapshot{ getLatest() };
+			if (!snapshot)
+				return "NONE\n";
+			return "SOLVED " + std::to_string(snapshot->solveNumber) + ' ' + getFingerprintString(snapshot->run) + ' ' + std::to_string(snapshot->unfilledSlots) + '\n';
+		}
+		if (command == "STAFF")
+			return getStaffTimetable(argument);
+		if (command == "CHECK") //answered from the check made when the roster was given
+		{
+			std::shared_ptr<const ServerRoster> roster{ getRoster() };
+			if (!roster->isLoaded())
+				return "ERROR nothing has been loaded\n";
+			std::string response{};
+			for (const std::string& shortage : roster->shortages)
+				response += shortage + '\n';
+			return response + "END\n";
+		}
+		return "ERROR unknown request\n";
+	}
+
+#if defined(__unix__) || defined(__APPLE__)
+	//answers requests from a connected client until it disconnects or sends QUIT or STOP, or the server is stopping
+	//the socket is left open for serve to close once this thread has been joined
+	void serveClient(Client& connection)
+	{
+		const int client{ connection.socket };
+		std::string buffer{}; //holds received bytes which do not yet form a whole request
+		std::array<char, 4096> received{};
+		while (true)
+		{
+			ssize_t count{ recv(client, received.data(), received.size(), 0) };
+			if (count <= 0)
+				break;
+			buffer.append(received.data(), static_cast<std::size_t>(count));
+
+			std::size_t end{ buffer.find('\n') };
+			bool quit{ false };
+			while (end != std::string::npos && !quit)
+			{
+				std::string request{ buffer.substr(0, end) };
+				buffer.erase(0, end + 1);
+				if (!request.empty() && request.back() == '\r')
+					request.pop_back();
+
+				quit = request == "QUIT" || request == "STOP";
+				if (request == "STOP")
+					stop();
+				std::string response{};
+				try
 				{
-					//swap an instance of the spot that is unfillable with the next activity in the list that has not been tried and add one to its quantities
-					filler.addToSlot(activitiesToFill[numberOfScheduleSlots + index]->getID());
-					std::swap(activitiesToFill[numberOfScheduleSlots + index], activitiesToFill[unfillable->getID() - m_activities[0].getID()]);
+					response = quit ? "BYE\n" : handle(request);
 				}
-				//if spot is staff
-				else if (unfillable->getType() == SpotWrapper::Type::Staff)
+				catch (...)
 				{
-					//swap an instance of the spot that is unfillable with the next activity in the list that has not been tried and add one to its quantities
-					filler.addToSlot(staffToFill[numberOfScheduleSlots + index]->getID());
-					std::swap(staffToFill[numberOfScheduleSlots + index], staffToFill[unfillable->getID() - m_staff[0].getID()]);
+					response = "ERROR invalid request\n";
 				}
-				//if spot is schedule slot
-				else
+
+				//sends the whole response even when the socket accepts it in parts
+				std::size_t sent{ 0 };
+				while (sent < response.size())
 				{
-					SpotWrapper* found{ std::find(m_startOfListPointer, m_startOfListPointer + m_endOfListID - m_startOfListID, [unfillable](SpotWrapper* spot)
-					{
-					 if (spot->getID() == unfillable->getID())
-					  return true;
-					 return false;
-					}) };
-
-					//swap
-					SpotWrapper* slot{ m_startOfListPointer + m_endOfListID - m_startOfListID - m_unfilledSlots };
-					SpotWrapper* temp{ slot };
-					*slot = *found;
-					*found = *temp;
-
-					++m_unfilledSlots;
+					ssize_t written{ send(client, response.data() + sent, response.size() - sent, 0) };
+					if (written <= 0)
+						break;
+					sent += static_cast<std::size_t>(written);
 				}
-
-				--index;
-				++swapIndex;
+				end = buffer.find('\n');
 			}
-  }
+			if (quit)
+				break;
+		}
+		connection.done = true;
 	}
 
-
+	//joins the threads of the clients which have stopped, or of every client once the server is stopping, and closes their sockets
+	void joinClients(const bool all)
+	{
+		for (auto client{ m_clients.begin() }; client != m_clients.end();)
+		{
+			if (!all && !client->done)
+			{
+				++client;
+				continue;
+			}
+			client->thread.join();
+			close(client->socket);
+			client = m_clients.erase(client);
+		}
+	}
+#endif
 
 public:
 
-	static std::array<ScheduleSlot, daysInCycle* periodsInDay> scheduleSlots;
+	//creates a server which solves with the given options
+	explicit SchedulingServer(const SolverOptions& options)
+		: m_options{ options },
+		m_pool{ options.workers }
+	{
+	}
 
-	ParticipantGroup() = default;
+	//makes serve stop accepting clients, let go of the clients it has and return, solves already queued are still finished
+	void stop()
+	{
+		m_stopping = true;
+	}
 
-	//use given pointers and lists to copy list of Schedule Slots, activities and staff and initialize member variables
-	ParticipantGroup(ScheduleSlot* startOfList, ScheduleSlot* endOfList, const std::vector<Activity>& activities, const std::vector<Staff>& staff, const int numberOfFilledSlots, std::vector<Activity*>& activitiesToFill, std::vector<Staff*>& staffToFill)
-		:m_startOfListPointer{ startOfList },
-		m_startOfListID{ startOfList->getID() },
-		m_endOfListID{ endOfList->getID() },
-		m_activities{ activities },
-		m_staff{ staff }
+	//serves requests on the unix domain socket at the given path until STOP is requested or stop is called
+	void serve(const std::string& socketPath)
 	{
-		std::copy(*startOfList, *endOfList, m_scheduleSlots); //gets copy so that we can fill spots using only slots in this group
-		m_participants= m_scheduleSlots[0].getNumberOfParticipants();
-		m_totalTimeSlots=m_scheduleSlots.size();
-		pruneActivities(activitiesToFill);
-		pruneStaff(staffToFill);
-		pruneScheduleSlots();
-		fill(activitiesToFill, staffToFill);
+#if defined(__unix__) || defined(__APPLE__)
+		int listener{ socket(AF_UNIX, SOCK_STREAM, 0) };
+		if (listener == -1)
+			throw "Socket could not be created\n";
+
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (socketPath.size() >= sizeof(address.sun_path))
+			throw "Socket path is too long\n";
+		std::copy(socketPath.begin(), socketPath.end(), address.sun_path);
+
+		unlink(socketPath.c_str()); //removes a socket left behind by a previous server
+		if (bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1 || listen(listener, 16) == -1)
+			throw "Socket could not be opened\n";
+
+		//the listener is polled rather than blocked on so the loop sees the stop flag, and clients which have left are joined as it goes
+		while (!m_stopping)
+		{
+			joinClients(false);
+			pollfd waiting{ listener, POLLIN, 0 };
+			if (poll(&waiting, 1, acceptInterval) <= 0)
+				continue;
+			int client{ accept(listener, nullptr, nullptr) };
+			if (client == -1)
+				continue;
+			Client& connection{ m_clients.emplace_back() };
+			connection.socket = client;
+			connection.thread = std::thread{ &SchedulingServer::serveClient, this, std::ref(connection) };
+		}
+		close(listener);
+		unlink(socketPath.c_str());
+
+		//wakes the clients still waiting for a request, then waits for them to finish
+		for (Client& client : m_clients)
+			shutdown(client.socket, SHUT_RDWR);
+		joinClients(true);
+#else
+		throw "Server mode is only supported on unix\n";
+#endif
 	}
+};
 
-	//gets total time slots
-	constexpr int getTotalTimeSlots() const
+
+//the files of one roster in a batch
+struct BatchRoster
+{
+	std::string schedulingPath{}; //path of the scheduling csv
+	std::string lockedPath{}; //path of the locked assignments csv, empty if the roster has none
+};
+
+//reads in the rosters of a batch from either a directory or a manifest
+//in a directory every csv file is a roster, and the locked assignments of "name.csv" are read from "name.locked.csv" when it exists
+//a manifest lists one roster per line as the path of its scheduling csv, optionally followed by a comma and the path of its locked csv
+std::vector<BatchRoster> readInBatch(const std::string& path)
+{
+	std::vector<BatchRoster> rosters{};
+	if (std::filesystem::is_directory(path))
 	{
-		return m_totalTimeSlots;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator{ path })
+		{
+			std::string fileName{ entry.path().filename().string() };
+			if (!entry.is_regular_file() || entry.path().extension() != ".csv" || fileName.ends_with(".locked.csv"))
+				continue;
+			std::filesystem::path lockedPath{ entry.path() };
+			lockedPath.replace_extension(".locked.csv");
+			rosters.push_back({ entry.path().string(), std::filesystem::exists(lockedPath) ? lockedPath.string() : std::string{} });
+		}
+		//directory order is unspecified so rosters are sorted to make batch output reproducible
+		std::sort(rosters.begin(), rosters.end(), [](const BatchRoster& roster1, const BatchRoster& roster2)
+			{
+				return roster1.schedulingPath < roster2.schedulingPath;
+			});
+		return rosters;
 	}
 
+	std::ifstream myReader{ path };
+	if (!myReader) //if reader fails to open file throw exception
+		throw "Batch could not be opened\n";
+	std::string line{};
+	while (std::getline(myReader, line))
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+			continue;
+		std::size_t comma{ line.find(',') };
+		rosters.push_back({ line.substr(0, comma), comma == std::string::npos ? std::string{} : line.substr(comma + 1) });
+	}
+	return rosters;
+}
 
+//solves every roster of a batch on the worker threads, writing each schedule next to its scheduling csv as "name_schedule_master.csv" and so on
+//returns 1 if any roster could not be solved so scripts can tell that the batch failed
+int solveBatch(const std::string& path, const SolverOptions& options)
+{
+	std::vector<BatchRoster> rosters{ readInBatch(path) };
+	std::vector<std::string> results(rosters.size()); //the summary line of each roster, written by the thread solving it
+	std::atomic<bool> failed{ false };
 
-	//prints out cyclical schedule
-	/*void printCycleSchedule()
 	{
-		for (std::size_t j{ 0 }; j < daysInCycle; ++j) //for each day in cycle
+		WorkerPool pool{ options.workers };
+		for (std::size_t index{ 0 }; index < rosters.size(); ++index)
 		{
-			for (std::size_t i{ 0 }; i < periodsInDay; ++i) //for each period in day, print the schedule slot
-				std::cout << i + 1 << ". " << scheduleSlots[j * 10 + i].getActivity()->getName() << "\n";
-			std::cout << "---------------------------\n"; //divider between days
+			pool.submit([&rosters, &results, &failed, &options, index]
+				{
+					const BatchRoster& files{ rosters[index] };
+					try
+					{
+						Roster roster{ readFile(files.schedulingPath), files.lockedPath.empty() ? std::string{} : readFile(files.lockedPath) };
+						if (roster.scheduling.empty())
+							throw "File could not be opened\n";
+
+						std::uint32_t seed{ options.seed.value_or(std::random_device{}()) };
+						SolvedSchedule snapshot{ solveRoster(roster, seed, options) };
+
+						std::filesystem::path prefix{ files.schedulingPath };
+						prefix.replace_extension();
+						writeSchedule(snapshot, prefix.string() + '_');
+
+						results[index] = files.schedulingPath + ": seed " + std::to_string(snapshot.run.seed) + ", run fingerprint " + getFingerprintString(snapshot.run) + ", " + std::to_string(snapshot.unfilledSlots) + " unfilled slots\n";
+					}
+					catch (const char* errorMessage)
+					{
+						results[index] = files.schedulingPath + ": " + errorMessage;
+						failed = true;
+					}
+					catch (...)
+					{
+						results[index] = files.schedulingPath + ": solve failed\n";
+						failed = true;
+					}
+				});
 		}
-	}*/
+	} //the pool finishes every solve before it is destroyed
 
-	constexpr int getUnfilledSlots() const
+	for (const std::string& result : results)
+		std::cerr << result;
+	return failed ? 1 : 0;
+}
+
+//reads in what-if scenarios of a loaded roster, one change per line, after a line of column headers
+//each line is the scenario's name followed by one of "drop,<activity>,<day>", "only,<staff>,<first period>-<last period>" or "from,<scenario>"
+//a scenario starts as the roster as it was read in, or as a fork of the scenario named by its first line when that is a "from" line
+std::vector<std::pair<std::string, Scenario>> readInScenarios(std::istream& myReader, const Scenario& base)
+{
+	std::vector<std::pair<std::string, Scenario>> scenarios{}; //the scenarios in the order they are first named
+	const LoadedRoster& roster{ base.getRoster() };
+
+	//gets the scenario with a given name, nullptr if it has not been named yet
+	auto findScenario{ [&scenarios](const std::string& name) -> Scenario*
+		{
+			auto found{ std::find_if(scenarios.begin(), scenarios.end(), [&name](const std::pair<std::string, Scenario>& scenario)
+				{
+					return scenario.first == name;
+				}) };
+			return found == scenarios.end() ? nullptr : &found->second;
+		} };
+
+	std::string line{};//holds line data
+	std::getline(myReader, line); //skips first line (column headers)
+
+	while (std::getline(myReader, line)) //while there are still changes to read in
 	{
-		return m_unfilledSlots;
+		if (!line.empty() && line.back() == '\r')
+			line.pop_back();
+		if (line.empty())
+			continue;
+
+		std::vector<std::string> columns{}; //holds the columns of this line
+		std::size_t comma{ line.find(',') }; //location of the break after the next column
+		while (comma != std::string::npos)
+		{
+			columns.push_back(line.substr(0, comma));
+			line = line.substr(comma + 1, line.size() - comma - 1); //removes column from line
+			comma = line.find(',');
+		}
+		columns.push_back(line);
+
+		if (columns.size() < 3)
+			throw "Scenario change is missing columns\n";
+
+		Scenario* scenario{ findScenario(columns[0]) };
+		if (columns[1] == "from")
+		{
+			Scenario* parent{ findScenario(columns[2]) };
+			if (scenario != nullptr || parent == nullptr)
+				throw "Scenario must be forked from an earlier scenario before it is changed\n";
+			scenarios.emplace_back(columns[0], parent->fork());
+			continue;
+		}
+
+		if (scenario == nullptr)
+			scenario = &scenarios.emplace_back(columns[0], base.fork()).second;
+		if (columns.size() < 4)
+			throw "Scenario change is missing columns\n";
+
+		if (columns[1] == "drop")
+		{
+			auto activity{ std::find_if(roster.activities.begin(), roster.activities.end(), [&columns](const Activity& activity)
+				{
+					return activity.getName() == columns[2];
+				}) };
+			int day{ std::stoi(columns[3]) - 1 };
+			if (activity == roster.activities.end() || day < 0 || day >= daysInCycle)
+				throw "Scenario drops an unknown activity or day\n";
+			scenario->dropActivity(activity->getID(), day);
+		}
+		else if (columns[1] == "only")
+		{
+			auto member{ std::find_if(roster.staff.begin(), roster.staff.end(), [&columns](const Staff& member)
+				{
+					return member.getName() == columns[2];
+				}) };
+			std::size_t dash{ columns[3].find('-') };
+			int firstPeriod{ std::stoi(columns[3].substr(0, dash)) - 1 };
+			int lastPeriod{ dash == std::string::npos ? firstPeriod : std::stoi(columns[3].substr(dash + 1)) - 1 };
+			if (member == roster.staff.end() || firstPeriod < 0 || lastPeriod < firstPeriod || lastPeriod >= periodsInDay)
+				throw "Scenario restricts an unknown staff or period\n";
+
+			TimeSet times{}; //the given periods of every day
+			for (int day{ 0 }; day < daysInCycle; ++day)
+			{
+				for (int period{ firstPeriod }; period <= lastPeriod; ++period)
+					times.set(day * periodsInDay + period);
+			}
+			scenario->restrictStaff(member->getID(), times);
+		}
+		else
+		{
+			throw "Scenario change is not drop, only or from\n";
+		}
 	}
+	return scenarios;
+}
+
+//solves "scheduling.csv" and every scenario of it in a given scenario csv on the worker threads, reading the roster in once
+//each schedule is written as "scenario_name_schedule_master.csv" and so on, the roster as it was read in being the scenario "base"
+//returns 1 if any scenario could not be solved so scripts can tell that a question had no answer
+int solveScenarios(const std::string& path, const SolverOptions& options)
+{
+	Roster roster{ readFile("scheduling.csv"), readFile("locked.csv") }; //reads in "scheduling.csv" and the optional "locked.csv"
+	if (roster.scheduling.empty()) //if reader fails to open file throw exception
+		throw "File could not be opened\n";
 
+	std::ifstream myReader{ path };
+	if (!myReader) //if reader fails to open file throw exception
+		throw "Scenarios could not be opened\n";
 
-};
+	Scenario base{ std::make_shared<const LoadedRoster>(loadRoster(roster)), getInputFingerprint(roster) };
+	std::vector<std::pair<std::string, Scenario>> scenarios{ readInScenarios(myReader, base) };
+	scenarios.emplace(scenarios.begin(), "base", base);
 
+	std::vector<std::string> results(scenarios.size()); //the summary line of each scenario, written by the thread solving it
+	std::atomic<bool> failed{ false };
+	std::uint32_t seed{ options.seed.value_or(std::random_device{}()) }; //every scenario uses the same seed so differences come from its changes
 
+	{
+		WorkerPool pool{ options.workers };
+		for (std::size_t index{ 0 }; index < scenarios.size(); ++index)
+		{
+			pool.submit([&scenarios, &results, &failed, &options, seed, index]
+				{
+					const auto& [name, scenario] { scenarios[index] };
+					try
+					{
+						LoadedRoster changed{ scenario.apply() };
+						SolvedSchedule snapshot{ solveLoadedRoster(changed, scenario.getInputFingerprint(), seed, options) };
+						writeSchedule(snapshot, "scenario_" + name + '_');
 
-//find next semicolon in given string
-std::size_t findNextSemi(std::string_view string)
-{
-	return string.find(':');
+						results[index] = name + ": run fingerprint " + getFingerprintString(snapshot.run) + ", " + std::to_string(snapshot.unfilledSlots) + " unfilled slots, preference cost " + std::to_string(snapshot.score.preferenceCost) + '\n';
+					}
+					catch (const char* errorMessage)
+					{
+						results[index] = name + ": " + errorMessage;
+						failed = true;
+					}
+					catch (...)
+					{
+						results[index] = name + ": solve failed\n";
+						failed = true;
+					}
+				});
+		}
+	} //the pool finishes every solve before it is destroyed
+
+	for (const std::string& result : results)
+		std::cerr << result;
+	return failed ? 1 : 0;
 }
 
-//find next comma in given string
-std::size_t findEnd(std::string_view string)
+//the impact on the schedule of removing one activity or staff member from a roster
+struct Criticality
 {
-	return string.find(',');
-}
+	std::string name{}; //name of the removed activity or staff member
+	bool isStaff{ false }; //stores whether a staff member rather than an activity was removed
+	bool isFeasible{ true }; //stores whether the roster could still be scheduled without them
+	std::string reason{}; //why the roster could not be scheduled, empty if it could
+	ScheduleScore score{}; //the score of the schedule solved without them
+};
 
-template <typename T, typename U>
-void getScheduleSlots(std::string& line, std::vector<U>& fillVector, std::vector <T>& scheduleSlots, const bool oneRange, const int offset)
+//re-solves a roster without each of its staff, and each of its activities when asked to, on the worker threads
+//every solve forks the same read-in roster so it is only read in once, and the results are ranked from most to least critical
+//a spot is the most critical when the roster cannot be scheduled without them, after that by how much worse the schedule is
+std::vector<Criticality> analyseCriticality(const Scenario& base, const std::uint32_t seed, const SolverOptions& options, ScheduleScore& baseScore)
 {
-	std::size_t(*endpoint)(std::string_view)(&findNextSemi); //initializes endpoint function pointer and sets it to point to find next semi
-	bool loopAgain{ true }; //controls whether or not the loop will continue iterating
-	while (loopAgain)	//loops while more time available ranges exist (while dividers exist plus once more)
+	const LoadedRoster& roster{ base.getRoster() };
+	std::vector<Criticality> results{};
+	std::vector<int> removedIDs{}; //ID of the spot removed by each result, -1 for the base roster which removes nothing
+	results.push_back({ "base", false });
+	removedIDs.push_back(-1);
+	for (const Staff& member : roster.staff)
 	{
-		if (line.find(':') == std::string::npos)//if range divider does not exist, stop looping after this iteration and search for boundary to times per cycle instead of between ranges
+		results.push_back({ std::string{ member.getName() }, true });
+		removedIDs.push_back(member.getID());
+	}
+	if (options.activityCriticality)
+	{
+		for (const Activity& activity : roster.activities)
 		{
-			loopAgain = false; //stop iterating (this is the last range)
-			endpoint = &findEnd; //set endpoint to comma (since that is the divider between csv columns)
+			results.push_back({ std::string{ activity.getName() }, false });
+			removedIDs.push_back(activity.getID());
 		}
+	}
 
-
-		std::size_t startRange{ static_cast<std::size_t>(std::stoi(line.substr(0, line.find('-')))) - 1 };//gets start of range
-		std::size_t endRange{ static_cast<std::size_t>(std::stoi(line.substr(line.find('-') + 1,endpoint(line)))) - 1 }; //gets end of range
-		for (std::size_t index{ startRange }; index <= endRange; ++index) //while within range update time available to true and iterate total times available
+	{
+		WorkerPool pool{ options.workers };
+		for (std::size_t index{ 0 }; index < results.size(); ++index)
 		{
-			if (oneRange)
-				fillVector.push_back(&scheduleSlots[index + offset]); //adds a pointer to the scheduleSlots at the given time to the list of times it can occur at
-			else
-			{
-				for (std::size_t j{ index }; j < static_cast<int>(Level::maxLevel) * daysInCycle * periodsInDay; j += daysInCycle * periodsInDay)
-					fillVector.push_back(&scheduleSlots[j]);
-			}
+			pool.submit([&base, &results, &removedIDs, &options, seed, index]
+				{
+					Criticality& result{ results[index] };
+					try
+					{
+						Scenario scenario{ base.fork() };
+						if (removedIDs[index] != -1)
+							scenario.removeSpot(removedIDs[index]);
+						LoadedRoster changed{ scenario.apply() };
+
+						//the shortages are kept as the reason rather than printed, since every thread would print them at once
+						std::vector<std::string> shortages{ checkFeasibility(changed.scheduleSlots, changed.activities, changed.staff, changed.lockedAssignments) };
+						if (!shortages.empty())
+						{
+							result.isFeasible = false;
+							result.reason = shortages[0];
+							return;
+						}
+						result.score = solveLoadedRoster(changed, scenario.getInputFingerprint(), seed, options).score;
+					}
+					catch (const char* errorMessage)
+					{
+						result.isFeasible = false;
+						result.reason = errorMessage;
+						if (!result.reason.empty() && result.reason.back() == '\n')
+							result.reason.pop_back();
+					}
+					catch (...)
+					{
+						result.isFeasible = false;
+						result.reason = "solve failed";
+					}
+				});
 		}
-		line = line.substr(endpoint(line) + 1, line.size() - endpoint(line)); //remove range added from range list
-	}
-}
+	} //the pool finishes every solve before it is destroyed
 
-template <typename T, typename U>
-void getScheduleSlots(std::string& line, std::vector<U>& fillVector, std::vector <T>& scheduleSlots)
-{
-	getScheduleSlots(line, fillVector, scheduleSlots, false, 0);
-}
+	if (!results[0].isFeasible)
+		throw "Roster cannot be scheduled\n";
+	baseScore = results[0].score;
+	results.erase(results.begin());
 
-template <typename T>
-void getScheduleSlots(std::string& line, std::vector<T*>& fillVector, std::vector <T>& scheduleSlots, const int offset)
-{
-	getScheduleSlots(line, fillVector, scheduleSlots, true, offset);
+	std::stable_sort(results.begin(), results.end(), [](const Criticality& result1, const Criticality& result2)
+		{
+			if (result1.isFeasible != result2.isFeasible)
+				return !result1.isFeasible;
+			return result2.score.isBetterThan(result1.score);
+		});
+	return results;
 }
-void getStrings(std::string_view line, std::vector<std::string>& fillVector)
+
+//writes the ranked results of a criticality analysis, with how much worse each schedule is than the schedule of the whole roster
+void writeCriticalityCsv(const std::string& fileName, const std::vector<Criticality>& results, const ScheduleScore& baseScore)
 {
-	std::size_t(*endpoint)(std::string_view)(&findNextSemi); //initializes endpoint function pointer and sets it to point to find next semi
-	bool loopAgain{ true }; //controls whether or not the loop will continue iterating
-	while (loopAgain)	//loops while more time available ranges exist (while dividers exist plus once more)
+	std::string output{ "Rank,Type,Name,Schedulable,Extra Unfilled Slots,Extra Preference Cost,Reason\n" };
+	for (std::size_t index{ 0 }; index < results.size(); ++index)
 	{
-		if (line.find(':') == std::string::npos)//if range divider does not exist, stop looping after this iteration and search for boundary to times per cycle instead of between ranges
+		const Criticality& result{ results[index] };
+		output += std::to_string(index + 1);
+		output += result.isStaff ? ",Staff," : ",Activity,";
+		output += result.name;
+		if (result.isFeasible)
 		{
-			loopAgain = false; //stop iterating (this is the last range)
-			endpoint = &findEnd; //set endpoint to comma (since that is the divider between csv columns)
+			output += ",yes,";
+			output += std::to_string(result.score.unfilledSlots - baseScore.unfilledSlots);
+			output += ',';
+			output += std::to_string(result.score.preferenceCost - baseScore.preferenceCost);
+			output += ",\n";
+		}
+		else
+		{
+			output += ",no,,,\"";
+			output += result.reason;
+			output += "\"\n";
 		}
-
-		fillVector.emplace_back(line.substr(0, endpoint(line))); //adds index to list of values in vector
-		line = line.substr(endpoint(line) + 1, line.size() - endpoint(line)); //remove range added from range list
 	}
+	writeFile(fileName, output);
 }
 
-//add activity category to categories vector
-//note: activities is non const since ActivityCategory intializer moves activity to its list of activities
-void createActivityCategory(std::vector <ActivityCategory>& categories, std::string_view category, std::vector<Activity>& activities)
+//reads in "scheduling.csv" once and writes the criticality of its staff, and its activities when asked to, to "criticality.csv"
+void runCriticalityAnalysis(const SolverOptions& options)
 {
-	std::sort(activities.begin(), activities.end(), [](Activity first, Activity second) //sorts activity list by total times available
+	Roster roster{ readFile("scheduling.csv"), readFile("locked.csv") }; //reads in "scheduling.csv" and the optional "locked.csv"
+	if (roster.scheduling.empty()) //if reader fails to open file throw exception
+		throw "File could not be opened\n";
+
+	Scenario base{ std::make_shared<const LoadedRoster>(loadRoster(roster)), getInputFingerprint(roster) };
+	std::uint32_t seed{ options.seed.value_or(std::random_device{}()) }; //every solve uses the same seed so differences come from the removed spot
+
+	ScheduleScore baseScore{};
+	std::vector<Criticality> results{ analyseCriticality(base, seed, options, baseScore) };
+	writeCriticalityCsv("criticality.csv", results, baseScore);
+
+	int critical{ static_cast<int>(std::count_if(results.begin(), results.end(), [](const Criticality& result)
 		{
-			return first.getTimesAvailable().size() < second.getTimesAvailable().size();
-		});
-	categories.push_back(ActivityCategory(category, activities));
+			return !result.isFeasible;
+		})) };
+	std::cerr << "seed " << seed << ", " << results.size() << " spots analysed, " << critical << " cannot be removed\n";
 }
 
-//takes in a list of activity names to search for and fills a list of pointers to those activities
-//note activities cannot be const since they are added to the activity list which may later be changed via their pointer
-void getActivities(const std::vector<std::string>& activityNames, std::vector<Activity*>& activityPointers, std::vector <Activity>& activities)
+//compares the slot mask kernels against searching pointer lists with std::find the way foundIndex used to, printing nanoseconds per query
+void runAvailabilityBenchmark(const std::uint32_t seed)
 {
-	for (std::size_t i{ 0 }; i < activityNames.size(); ++i) //loops through all activities we are searching for
+	std::mt19937 mt{ seed }; //merene twister, seeded so the benchmark sees the same spots every run
+	constexpr int numberOfSlots{ static_cast<int>(Level::maxLevel) * daysInCycle * periodsInDay };
+	constexpr int numberOfSpots{ 300 }; //activities and staff in a large roster
+	constexpr int numberOfQueries{ 1000000 };
+
+	std::vector<ScheduleSlot> slots{};
+	for (int index{ 0 }; index < numberOfSlots; ++index)
+		slots.emplace_back(index % (daysInCycle * periodsInDay), static_cast<Level>(index / (daysInCycle * periodsInDay)), index);
+
+	//gives each spot a random two thirds of the slots, as both a pointer list and a mask
+	std::vector<std::vector<ScheduleSlot*>> lists(numberOfSpots);
+	std::vector<SlotMask> masks(numberOfSpots);
+	std::uniform_int_distribution<int> slotDistribution{ 0, numberOfSlots - 1 };
+	std::uniform_int_distribution<int> spotDistribution{ 0, numberOfSpots - 1 };
+	for (int spot{ 0 }; spot < numberOfSpots; ++spot)
 	{
-		bool loopAgain{ true }; //control variable that allows the process to skip to searching for next activity once the activity has been found
-		for (std::size_t k{ 0 }; k < activities.size() && loopAgain; ++k) //loops through activities while there are more to search and the activity has not yet been found
+		for (int index{ 0 }; index < numberOfSlots; ++index)
 		{
-
-			if (activities[k].getName() == activityNames[i]) //if the activity is the activity we are searching for (it has the same name as the next activity in the list of activities we are searching for)
+			if (slotDistribution(mt) % 3 != 0)
 			{
-				activityPointers.push_back(&(activities[k])); //add a pointer to the activity to the activities vector
-				loopAgain = false; //marks activity as found, allowing process to skip to next activity
+				lists[spot].push_back(&slots[index]);
+				masks[spot].set(slots[index].getID());
 			}
 		}
+		std::shuffle(lists[spot].begin(), lists[spot].end(), mt);
 	}
-}
 
+	std::vector<std::pair<int, int>> queries(numberOfQueries);
+	for (auto& [spot, slot] : queries)
+		spot = spotDistribution(mt), slot = slotDistribution(mt);
 
-//initializes static array scheduleSlots before use
-std::array<ScheduleSlot, daysInCycle* periodsInDay> ParticipantGroup::scheduleSlots;
+	//times a given function over every query and prints the result
+	auto time{ [&queries](std::string_view name, auto function)
+		{
+			long long checksum{ 0 }; //keeps the compiler from removing the work
+			auto start{ std::chrono::steady_clock::now() };
+			for (const auto& [spot, slot] : queries)
+				checksum += function(spot, slot);
+			std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+			std::cout << name << ": " << elapsed.count() / queries.size() << " ns per query (checksum " << checksum << ")\n";
+		} };
+
+	time("membership, std::find", [&](int spot, int slot)
+		{
+			return static_cast<int>(std::find(lists[spot].begin(), lists[spot].end(), &slots[slot]) != lists[spot].end());
+		});
+	time("membership, slot mask", [&](int spot, int slot)
+		{
+			return static_cast<int>(masks[spot].test(slots[slot].getID()));
+		});
+	time("first common slot, std::find", [&](int spot, int slot)
+		{
+			int other{ slot % numberOfSpots };
+			for (int index{ 0 }; index < numberOfSlots; ++index)
+			{
+				if (std::find(lists[spot].begin(), lists[spot].end(), &slots[index]) != lists[spot].end() && std::find(lists[other].begin(), lists[other].end(), &slots[index]) != lists[other].end())
+					return index;
+			}
+			return -1;
+		});
+	time("first common slot, slot mask", [&](int spot, int slot)
+		{
+			return masks[spot].findFirstCommon(masks[slot % numberOfSpots]);
+		});
+	time("common slot count, slot mask", [&](int spot, int slot)
+		{
+			return masks[spot].countCommon(masks[slot % numberOfSpots]);
+		});
+#if defined(__AVX2__)
+	std::cout << "slot masks used AVX2\n";
+#else
+	std::cout << "slot masks used the scalar fallback\n";
+#endif
+}
 
-//takes in list of avilable times for a staff to elad at and adds a pointer to the schedule slot at each of those times to the scheduleSlotsAvailable list
-void getScheduleSlots(const std::vector<std::size_t> avail, std::vector<ScheduleSlot*> scheduleSlotsAvailable)
+//a roster held in memory for the C interface, kept as the sections of its scheduling csv so rows can be added to each of them
+//the roster is read in once and kept, each solve copying it into the same working roster so their memory is reused
+struct ApplewoodProblem
 {
-	for (std::size_t i{ 0 }; i < avail.size() * static_cast<int>(Level::maxLevel); ++i)
+	std::string header{ "Activity\n" }; //the column headers of the scheduling csv
+	std::string activities{}; //the activity rows of the scheduling csv
+	std::string staffLine{ "Staff\n" }; //the line which ends the activities and starts the staff
+	std::string staff{}; //the staff rows of the scheduling csv
+	std::string participantLine{ "Partcipants\n" }; //the line which ends the staff and starts the participants
+	std::string participants{}; //the participant rows of the scheduling csv
+	std::string locked{}; //the locked assignments csv, with its column headers
+
+	std::optional<LoadedRoster> loaded{}; //the roster read in from the rows, empty until the next solve once a row is added
+	std::uint64_t inputFingerprint{}; //the fingerprint of the roster read in
+	LoadedRoster working{}; //the copy of the roster the last solve filled, kept so the next copy reuses its memory
+	std::optional<SolvedSchedule> solved{}; //the last schedule solved
+	std::string error{}; //why the last call failed, empty if it did not
+
+	//joins the sections back into a roster
+	Roster getRoster() const
 	{
-		scheduleSlotsAvailable.push_back(&ParticipantGroup::scheduleSlots[i % (periodsInDay * daysInCycle)]);
+		return { header + activities + staffLine + staff + participantLine + participants, locked };
 	}
-	//adds slots at the same time to each slot's list
-	for (std::size_t i{ 0 }; i < avail.size() * static_cast<int>(Level::maxLevel); ++i)
+
+	//copies the read in roster into the working roster, constructing the spots in the vectors of the last solve so their memory is reused
+	void copyToWorking()
 	{
-		for (std::size_t j{ i % avail.size() }; j < static_cast<int>(Level::maxLevel); j += avail.size())
-		{
-			if (i != j)
-				scheduleSlotsAvailable[i]->addSlotAtSameTime(scheduleSlotsAvailable[j]);
-		}
+		auto copy{ [](auto& to, const auto& from)
+			{
+				to.clear(); //keeps the capacity
+				for (const auto& spot : from)
+					to.push_back(spot);
+			} };
+		copy(working.scheduleSlots, loaded->scheduleSlots);
+		copy(working.activities, loaded->activities);
+		copy(working.staff, loaded->staff);
+		copy(working.lockedAssignments, loaded->lockedAssignments);
 	}
-}
+};
 
-//takes in a string and a breakpoint and fiils the inputted activity pointers vector with activity pointers to the activites found within the string
-void processActivitiesListFromFileToVectorofActivityPointers(std::string_view line, std::vector<Activity*>& activityPointers, std::vector <Activity>& activities, const std::size_t breakLocation)
+//adds a row to one section of a problem, ending it with a new line
+void addRow(ApplewoodProblem* problem, std::string& section, const char* row)
 {
-	std::string raw{ line.substr(0,breakLocation) };  //hold raw list of activities
-	std::vector<std::string> names{}; //holds list of activities names
-	getStrings(raw, names); //processes raw list and fills list of activities names
-	getActivities(names, activityPointers, activities); //gets list of pointers to activities using their names and fills activity pointers vector
+	section += row;
+	if (section.empty() || section.back() != '\n')
+		section += '\n';
+	problem->loaded.reset(); //read in again at the next solve
+	problem->error.clear();
 }
 
-//reads in staff from file and stores in the staff vector
-//note activities is non const due to getActivities
-void readInStaff(std::ifstream& myReader, std::vector <Activity>& activities, std::vector <Staff>& staff)
+//runs a call of the C interface on a problem, adding the message of anything it throws to the problem's error
+template <typename Function>
+int runApplewoodCall(ApplewoodProblem* problem, Function call)
 {
-	std::string line{};//holds line data
-	while (true) //iterates for each staff in the file
+	if (problem == nullptr)
+		return APPLEWOOD_ERROR;
+	try
 	{
+		problem->error.clear();
+		call();
+		return APPLEWOOD_OK;
+	}
+	catch (const char* errorMessage)
+	{
+		problem->error += errorMessage;
+	}
+	catch (...)
+	{
+		problem->error += "solve failed\n";
+	}
+	return APPLEWOOD_ERROR;
+}
 
-		std::getline(myReader, line);
-		std::size_t breakLocation{ line.find(',') };//location of break between staff name and preferred lead activities
-		std::string name{ line.substr(0,breakLocation) }; //holds staff name
-
-		if (name == "Partcipants") //Once participants is read in, starts to read in participants
-			break;
-
-
-		line = line.substr(breakLocation + 1, line.size()); //line removes staff name and break
-		std::vector<Activity*> preferred{}; //holds list of pointers to preffered activites
-		breakLocation = line.find(','); //location of next breakpoint (at the end of the list of preffered activites)
-		processActivitiesListFromFileToVectorofActivityPointers(line, preferred, activities, breakLocation); //fills preferred vector with pointer to activities between the previous and current breakpoints
-
-		line = line.substr(breakLocation + 1, line.size()); //line removes list of preferred names and break
-		std::vector<Activity*> neutral{}; //holds list of pointers to preffered activites
-		breakLocation = line.find(','); //location of next breakpoint (at the end of the list of neutral activites)
-		processActivitiesListFromFileToVectorofActivityPointers(line, neutral, activities, breakLocation); //fills neutral vector with pointer to activities between the previous and current breakpoints
+extern "C"
+{
+	int applewood_api_version(void)
+	{
+		return APPLEWOOD_API_VERSION;
+	}
 
-		line = line.substr(breakLocation + 1, line.size()); //line removes neutral names and break
-		std::vector<Activity*> unpreferred{}; //holds list of pointers to preffered activites
-		breakLocation = line.find(','); //location of next breakpoint (at the end of the list of unpreferred activites)
-		processActivitiesListFromFileToVectorofActivityPointers(line, unpreferred, activities, breakLocation); //fills unpreferred vector with pointer to activities between the previous and current breakpoints
+	ApplewoodProblem* applewood_create(const char* scheduling, size_t schedulingSize, const char* locked, size_t lockedSize)
+	{
+		try
+		{
+			auto problem{ std::make_unique<ApplewoodProblem>() };
+			if (locked != nullptr)
+				problem->locked.assign(locked, lockedSize);
 
-		line = line.substr(breakLocation + 1, line.size()); //line removes unpreferred names and break
-		std::vector<std::size_t> staffBreaks{}; //stores vector of break times for this staff member
-		getScheduleSlots(line, staffBreaks, staff); //gets staff breaks from line and adds ranges to staffBreaks vector
-		std::size_t j{ 0 }; //holds the time of the next break as we search through all schedule slots
-		std::vector < std::size_t > availableTimes{}; //holds all the schedule slots where the staff can lead (not break times)
-		for (std::size_t i{ 0 }; i < periodsInDay * daysInCycle; ++i) //loops throough all possible schedule slots
+			//splits the scheduling csv into its sections, the lines which are missing keep their defaults
+			RosterSections sections{ findRosterSections(scheduling == nullptr ? std::string_view{} : std::string_view{ scheduling, schedulingSize }) };
+			auto copyLine{ [](std::string& to, std::string_view line)
+				{
+					if (line.empty())
+						return;
+					to = line;
+					if (to.back() != '\n') //the last line of the csv may have no line break
+						to += '\n';
+				} };
+			copyLine(problem->header, sections.header);
+			copyLine(problem->staffLine, sections.staffLine);
+			copyLine(problem->participantLine, sections.participantLine);
+			problem->activities = sections.activities;
+			problem->staff = sections.staff;
+			problem->participants = sections.participants;
+			return problem.release();
+		}
+		catch (...)
 		{
-			if (i != staffBreaks[j]) //if the schedule slot is not in the break list
-				availableTimes.push_back(i); //add the index of the schedule slot to the times available vector
-			else if (j < staffBreaks.size() - 1) //if the schedule slot is in the break list and it is not the last break
-				++j; //iterate to check the next break schedule slot
+			return nullptr;
 		}
-		std::vector<ScheduleSlot*> timesAvailable{}; //holds pointers to the schedule slots corresponding to the times the staff can lead at
-		getScheduleSlots(availableTimes, timesAvailable); //fills the list of pointers using the indecies of the times that the staff can lead at 
+	}
 
-		staff.emplace_back(name, 10, preferred, neutral, unpreferred, timesAvailable); //adds staff member to staff vector
+	int applewood_add_activity(ApplewoodProblem* problem, const char* row)
+	{
+		return runApplewoodCall(problem, [problem, row] { addRow(problem, problem->activities, row); });
+	}
 
+	int applewood_add_staff(ApplewoodProblem* problem, const char* row)
+	{
+		return runApplewoodCall(problem, [problem, row] { addRow(problem, problem->staff, row); });
 	}
-}
 
-//reads in activitiy info, creates activity objects and stores them in activities vector
-void readInActivities(std::ifstream& myReader, std::vector <Activity>& activities, std::vector <ScheduleSlot>& scheduleSlots)
-{
+	int applewood_add_participant(ApplewoodProblem* problem, const char* row)
+	{
+		return runApplewoodCall(problem, [problem, row] { addRow(problem, problem->participants, row); });
+	}
 
-	std::string line{};//holds line data
-	std::getline(myReader, line); //skips first line (column headers)
+	int applewood_add_locked(ApplewoodProblem* problem, const char* row)
+	{
+		return runApplewoodCall(problem, [problem, row]
+			{
+				if (problem->locked.empty()) //the first line of the locked csv is skipped as its column headers
+					problem->locked = "Day,Period,Level,Activity,Staff\n";
+				addRow(problem, problem->locked, row);
+			});
+	}
 
-	while (true) //loops until broken (when staff starts to be read in), reasds one activity at a time ine
+	int applewood_solve(ApplewoodProblem* problem, const ApplewoodSolveOptions* options)
 	{
-		std::getline(myReader, line); //gets line
-		std::size_t comma{ line.find(',') };//location of break between category name and activity name
-		std::string categoryName{ line.substr(0,comma) }; //category name
+		return runApplewoodCall(problem, [problem, options]
+			{
+				if (!problem->loaded)
+				{
+					Roster roster{ problem->getRoster() };
+					problem->loaded = loadRoster(roster);
+					problem->inputFingerprint = getInputFingerprint(roster);
+				}
 
-		if (categoryName == "Staff") //once staff is hit breaks and starts to read in staff
-			break;
-		std::size_t comma{ line.find(',') }; //find break between activity name and activity times available
-		std::string activityName{ line.substr(0,comma) }; //stores activity name
-		line = line.substr(comma + 1, line.size() - comma - 1); //removes activty name from line
-		std::vector < ScheduleSlot* > timesAvailable{};//array storing if activity is available at each time slot
+				SolverOptions solverOptions{};
+				solverOptions.workers = 1;
+				if (options != nullptr)
+				{
+					if (options->hasSeed)
+						solverOptions.seed = options->seed;
+					if (options->timeLimit > 0.0)
+						solverOptions.timeLimit = options->timeLimit;
+					if (options->iterationLimit > 0)
+						solverOptions.iterationLimit = options->iterationLimit;
+					solverOptions.neighbourhoodIterations = std::max(0, options->neighbourhoodIterations);
+					solverOptions.matching = options->matching != 0;
+					solverOptions.symmetry = options->noSymmetry == 0;
+				}
 
-		getScheduleSlots(line, timesAvailable, scheduleSlots); //gets times available from line and adds it to times avaliable vector
+				problem->solved.reset(); //a failed solve leaves no schedule rather than the one before it
+				problem->copyToWorking();
 
-		int timesPerCycle{ std::stoi(line) }; //rest of line after times avaible is times per cycle
+				//the shortages are returned in the error rather than printed, since the library does not own the error stream
+				for (const std::string& shortage : checkFeasibility(problem->working.scheduleSlots, problem->working.activities, problem->working.staff, problem->working.lockedAssignments))
+					problem->error += shortage + '\n';
+				if (!problem->error.empty())
+					throw "Roster cannot be scheduled\n";
 
-		activities.push_back(Activity(activityName, timesPerCycle, timesAvailable)); //add activity to activities array
+				std::uint32_t seed{ solverOptions.seed.value_or(std::random_device{}()) };
+				problem->solved = solveLoadedRoster(problem->working, problem->inputFingerprint, seed, solverOptions);
+			});
 	}
-}
 
-//adds a schedule slot for each time period per level to the scheduleSlots vector
-void assignScheduleSlots(std::vector <ScheduleSlot>& scheduleSlots)
-{
-	for (std::size_t index{ 0 }; index < periodsInDay * daysInCycle * static_cast<int>(Level::maxLevel); ++index)
-		scheduleSlots.emplace_back(index % (periodsInDay * daysInCycle));
-}
+	size_t applewood_assignment_count(const ApplewoodProblem* problem)
+	{
+		return problem == nullptr || !problem->solved ? 0 : problem->solved->schedule.activityIDs.size();
+	}
 
-//reads in participants and adds them to each schedule slot they are participating in
-void readInParticipants(std::ifstream& myReader, std::vector <ScheduleSlot>& scheduleSlots)
-{
-	std::string line{};//holds line data
-	while (std::getline(myReader, line)) //while there are still participants to read in
+	int applewood_get_assignment(const ApplewoodProblem* problem, size_t index, ApplewoodAssignment* assignment)
 	{
-		std::size_t comma{ line.find(',') };//location of break between participant name and times available
-		line = line.substr(comma + 1, line.size() - comma - 1); //removes participant name from line
-		char groupLevel{ line[0] };
-		Level level{ getLevel(groupLevel) }; //converts level char to Level enum type
-		line = line.substr(2, line.size() - 2); //removes participant group level from line so it only contains the participant's times available.
+		if (assignment == nullptr || index >= applewood_assignment_count(problem))
+			return APPLEWOOD_ERROR;
+
+		//slots are stored level by level, each level holding every period of every day
+		const SolvedSchedule& solved{ *problem->solved };
+		int slotID{ static_cast<int>(index) };
+		int time{ getSlotTime(slotID) };
+		assignment->day = time / periodsInDay + 1;
+		assignment->period = time % periodsInDay + 1;
+		assignment->level = static_cast<char>('A' + slotID / (periodsInDay * daysInCycle));
+		assignment->participants = solved.participants[index];
+		bool isFilled{ solved.schedule.isFilled(slotID) };
+		assignment->activity = isFilled ? solved.names[solved.schedule.activityIDs[index]].c_str() : nullptr;
+		assignment->staff = isFilled ? solved.names[solved.schedule.staffIDs[index]].c_str() : nullptr;
+		return APPLEWOOD_OK;
+	}
 
+	const char* applewood_get_assistant(const ApplewoodProblem* problem, size_t index, size_t assistant)
+	{
+		if (index >= applewood_assignment_count(problem))
+			return nullptr;
+		const std::vector<int>& assistantIDs{ problem->solved->schedule.assistantIDs[index] };
+		return assistant < assistantIDs.size() ? problem->solved->names[assistantIDs[assistant]].c_str() : nullptr;
+	}
 
-		std::vector < ScheduleSlot* > timesAvailable{};//array storing if participant is available at each time slot
+	int applewood_get_summary(const ApplewoodProblem* problem, ApplewoodSummary* summary)
+	{
+		if (problem == nullptr || !problem->solved || summary == nullptr)
+			return APPLEWOOD_ERROR;
+		const SolvedSchedule& solved{ *problem->solved };
+		*summary = { solved.unfilledSlots, solved.score.preferenceCost, solved.budgetExhausted ? 1 : 0, solved.run.seed, solved.run.fingerprint };
+		return APPLEWOOD_OK;
+	}
 
-		getScheduleSlots(line, timesAvailable, scheduleSlots, static_cast<int>(level) * periodsInDay * daysInCycle); //gets times available from line and adds it to times avaliable vector
+	const char* applewood_last_error(const ApplewoodProblem* problem)
+	{
+		return problem == nullptr ? "no problem given\n" : problem->error.c_str();
+	}
 
-		for (ScheduleSlot* scheduleSlot : timesAvailable) //adds participant to schedule slots at the times they are participating in their level
-			scheduleSlot->addParticipant();
+	void applewood_free(ApplewoodProblem* problem)
+	{
+		delete problem;
 	}
 }
 
-//fills given fill list with spots to be filled
-template <typename T>
-void fillFillList(std::vector <T*> spotsToFill, std::vector <T>& spots, const int length)
+#if !defined(APPLEWOOD_LIBRARY) //the library is used through the C interface instead
+int main(int argc, char* argv[])
 {
-	for (std::size_t index{ 0 }; index < length; ++index)
+	try
 	{
-		//finds the activity with the highest ratio of remaining spots to total spots
-		T* nextSpot{ &spots[0] };
-		for (std::size_t spotIndex{ 1 }; spotIndex < spots.size(); ++spotIndex)
+		try
 		{
-			if (nextSpot->getTimesLeftToFill() / nextSpot->getTimesToFill() < spots[spotIndex]->getTimesLeftToFill() / spots[spotIndex]->getTimesToFill())
-				nextSpot = &spots[spotIndex];
-			//locks in slot to be added in its ratio is max possible (1)
-			if (nextSpot->getTimesLeftToFill() == nextSpot->getTimesToFill())
-				break;
-		}
-		//adds found spot as next in list and updates accordingly
-		spotsToFill.push_back(nextSpot);
-		nextActivity.setTimesLeftToFill(nextSpot.getTimesLeftToFill() - 1);
-	}
-}
+			SolverOptions options{ readInOptions(argc, argv) }; //reads in command line options
 
+			if (options.benchmark) //measures the availability kernels instead of solving
+			{
+				runAvailabilityBenchmark(options.seed.value_or(0));
+				return 0;
+			}
 
-int main()
-{
+			if (options.socketPath) //serves requests until a client sends STOP instead of running a single solve
+			{
+				SchedulingServer server{ options };
+				server.serve(*options.socketPath);
+				return 0;
+			}
 
+			if (options.batchPath) //solves every roster of a batch instead of a single roster
+				return solveBatch(*options.batchPath, options);
 
+			if (options.scenarioPath) //solves what-if scenarios of the roster instead of the roster alone
+				return solveScenarios(*options.scenarioPath, options);
 
+			if (options.criticality) //ranks how much the schedule depends on each staff member instead of writing a schedule
+			{
+				runCriticalityAnalysis(options);
+				return 0;
+			}
 
-	//ParticipantGroup testGroup{ 1,timeSlots,50 };
+			std::uint32_t seed{ options.seed.value_or(std::random_device{}()) }; //uses the given seed, otherwise generates one using the OS's random device
 
-	std::vector <ScheduleSlot> scheduleSlots{};
-	std::vector <Activity> activities{};
-	std::vector <Staff> staff{};
+			Roster roster{ readFile("scheduling.csv"), readFile("locked.csv") }; //reads in "scheduling.csv" and the optional "locked.csv"
+			if (roster.scheduling.empty()) //if reader fails to open file throw exception
+				throw "File could not be opened\n";
 
-	assignScheduleSlots(scheduleSlots);
+			SolvedSchedule snapshot{ solveRoster(roster, seed, options) };
+			writeSchedule(snapshot); //writes the schedule views for printing and app sync
 
-	try
-	{
-		try
-		{
-			std::ifstream myReader{ "scheduling.csv" }; //selects file "scheduling.csv" to read in
-			if (!myReader) //if reader fails to open file throw exception
-				throw "File could not be opened\n";
-			
-			readInActivities(myReader, activities, scheduleSlots); //reads in activities and assigns them to the activities vector
-			readInStaff(myReader, activities, staff); //reads in staff
-			readInParticipants(myReader, scheduleSlots); //reads in paticipants
+			//prints the seed and fingerprint of this run so that it can be reproduced
+			std::cerr << "seed " << snapshot.run.seed << ", run fingerprint " << getFingerprintString(snapshot.run) << ", " << snapshot.unfilledSlots << " unfilled slots" << (snapshot.budgetExhausted ? " (stopped at the solve limit)" : "") << '\n';
+			for (std::size_t index{ 0 }; index < snapshot.alternatives.size(); ++index)
+				std::cerr << "pool schedule " << index + 2 << ", " << snapshot.alternativeScores[index].unfilledSlots << " unfilled slots, preference cost " << snapshot.alternativeScores[index].preferenceCost << ", " << getScheduleDistance(snapshot.schedule, snapshot.alternatives[index]) << " slots differ from the solved schedule\n";
 		}
 		catch (const char* errorMessage) //if file could not be opened
 		{
@@ -1452,46 +6246,8 @@ int main()
 	catch (...)
 	{
 		std::cerr << "A fatal error has occured\n";
+		return 1;
 	}
-
-	//sorts scheduleSlots by most participants
-	std::sort(scheduleSlots.begin(), scheduleSlots.end(), [](ScheduleSlot& first, ScheduleSlot& second)
-		{
-			return first.getNumberOfParticipants() > second.getNumberOfParticipants();
-		});
-
-	std::vector <ScheduleSlot*> startOfBlocks{ &scheduleSlots[0] }; //holds the starting slot of each block of schedule slots with same number of participants
-	std::vector <ParticipantGroup> participantGroups{}; //holds all blocks 
-
-	//loop through sorted list of schedule slots
-	for (auto& endOfBlock : scheduleSlots)
-	{
-		//starts new block when number of participants change
-		if (endOfBlock.getNumberOfParticipants() != startOfBlocks[startOfBlocks.size() - 1]->getNumberOfParticipants())
-			startOfBlocks.push_back(& endOfBlock);
-	}
-
-	int unfilledSlots{ 0 };
-
-	//holds order of activities and staff to be filled
-	std::vector <Activity*> activitiesToFill{};
-	std::vector <Staff*> staffToFill{};
-
-	//fills activity as staff fill lists
-	fillFillList(activitiesToFill, activities, scheduleSlots.size());
-	fillFillList(staffToFill, staff, scheduleSlots.size());
-
-	//creates participant group blocks and adds them to list
-	for (std::size_t index{ 1 }; index < startOfBlocks.size(); ++index)
-	{
-		participantGroups.emplace_back( ParticipantGroup(startOfBlocks[index - 1] - unfilledSlots, startOfBlocks[index] - 1, activities, staff,startOfBlocks[index - 1] - unfilledSlots - startOfBlocks[0], activitiesToFill, staffToFill) );
-		//updates number of unfilled spots
-		unfilledSlots = participantGroups[participantGroups.size() - 1].getUnfilledSlots();
-	}
-
-	//testGroup.addActivities(categories, maxID);
-
-	std::cerr << "1";
 	/*std::vector <ActivityCategory> ActivityCategories{};
 
 
@@ -1515,3 +6271,4 @@ int main()
 	}
 	*/
 }
+#endif
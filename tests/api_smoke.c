@@ -0,0 +1,145 @@
+//solves a small roster through the C interface and checks every slot it returns
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//three activities open all cycle and one participant per level at every time, so every slot can be filled
+static const char scheduling[] =
+	"Activity,Times available,Times per cycle\n"
+	"Archery,1-50,50\n"
+	"Canoeing,1-50,50\n"
+	"Crafts,1-50,50\n"
+	"Staff\n"
+	"Partcipants\n"
+	"Ada,A,1-50\n"
+	"Ben,B,1-50\n"
+	"Cal,C,1-50\n";
+
+//checks that a roster with one bad activity or staff row fails to solve with the reader's error rather than reading the bad number as 0
+static int rejectsRow(const int isActivity, const char* row, const char* error)
+{
+	ApplewoodProblem* problem = applewood_create(scheduling, sizeof scheduling - 1, NULL, 0);
+	if (problem == NULL)
+		return !fail(NULL, "applewood_create");
+	if ((isActivity ? applewood_add_activity(problem, row) : applewood_add_staff(problem, row)) != APPLEWOOD_OK)
+		return !fail(problem, "adding the row");
+	if (applewood_solve(problem, NULL) == APPLEWOOD_OK || strstr(applewood_last_error(problem), error) == NULL)
+	{
+		fprintf(stderr, "%s was not rejected with \"%s\"\n", row, error);
+		return !fail(problem, "applewood_solve");
+	}
+	applewood_free(problem);
+	return 1;
+}
+
+//checks that locked assignments are kept in the solved schedule, or that an extra lock is reported before solving with a given error
+//Staff4 can lead 2 slots a day and 2 in a row, and is locked into the first two periods of day 1
+static int checkLocks(const char* extraLock, const char* error)
+{
+	ApplewoodProblem* problem = applewood_create(scheduling, sizeof scheduling - 1, NULL, 0);
+	ApplewoodAssignment assignment;
+	char row[64];
+	size_t index;
+	if (problem == NULL)
+		return !fail(NULL, "applewood_create");
+	for (index = 0; index < 15; ++index)
+	{
+		sprintf(row, "Staff%d,Archery,Canoeing:Crafts,,%s", (int)index, index == 4 ? ",0,10,2,2" : "");
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return !fail(problem, "applewood_add_staff");
+	}
+	if (applewood_add_locked(problem, "1,1,B,Crafts,Staff4") != APPLEWOOD_OK || applewood_add_locked(problem, "1,2,B,Crafts,Staff4") != APPLEWOOD_OK)
+		return !fail(problem, "applewood_add_locked");
+
+	if (extraLock != NULL)
+	{
+		if (applewood_add_locked(problem, extraLock) != APPLEWOOD_OK)
+			return !fail(problem, "applewood_add_locked");
+		if (applewood_solve(problem, NULL) == APPLEWOOD_OK || strstr(applewood_last_error(problem), error) == NULL)
+		{
+			fprintf(stderr, "the lock %s was not rejected with \"%s\"\n", extraLock, error);
+			return !fail(problem, "applewood_solve");
+		}
+		applewood_free(problem);
+		return 1;
+	}
+	if (applewood_solve(problem, NULL) != APPLEWOOD_OK)
+		return !fail(problem, "solving with locked assignments");
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return !fail(problem, "applewood_get_assignment");
+		if (assignment.day == 1 && assignment.period <= 2 && assignment.level == 'B' && (assignment.activity == NULL || strcmp(assignment.activity, "Crafts") != 0 || strcmp(assignment.staff, "Staff4") != 0))
+			return !fail(problem, "a locked assignment was not kept\n");
+	}
+	applewood_free(problem);
+	return 1;
+}
+
+int main(void)
+{
+	ApplewoodProblem* problem;
+	ApplewoodSolveOptions options;
+	ApplewoodAssignment assignment;
+	ApplewoodSummary summary;
+	char row[64];
+	size_t index;
+	int filled = 0;
+
+	if (applewood_api_version() != APPLEWOOD_API_VERSION)
+		return fail(NULL, "api version");
+
+	problem = applewood_create(scheduling, sizeof scheduling - 1, NULL, 0);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+
+	//each staff member leads at most 10 slots by default, so 15 of them are needed for the 150 slots
+	for (index = 0; index < 15; ++index)
+	{
+		sprintf(row, "Staff%d,Archery,Canoeing:Crafts,,", (int)index);
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+
+	memset(&options, 0, sizeof options);
+	options.seed = 1;
+	options.hasSeed = 1;
+	options.timeLimit = 30.0;
+	if (applewood_solve(problem, &options) != APPLEWOOD_OK)
+		return fail(problem, "applewood_solve");
+
+	if (applewood_assignment_count(problem) != 150)
+		return fail(problem, "applewood_assignment_count\n");
+
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return fail(problem, "applewood_get_assignment");
+		if (assignment.day < 1 || assignment.day > 5 || assignment.period < 1 || assignment.period > 10 || assignment.level < 'A' || assignment.level > 'C')
+			return fail(problem, "slot out of range\n");
+		if ((assignment.activity == NULL) != (assignment.staff == NULL))
+			return fail(problem, "slot has an activity without staff or staff without an activity\n");
+		if (assignment.activity != NULL)
+			++filled;
+	}
+	if (applewood_get_assignment(problem, index, &assignment) == APPLEWOOD_OK)
+		return fail(problem, "applewood_get_assignment past the last slot\n");
+
+	if (applewood_get_summary(problem, &summary) != APPLEWOOD_OK)
+		return fail(problem, "applewood_get_summary");
+	if (summary.unfilledSlots != 150 - filled || summary.seed != 1)
+		return fail(problem, "summary does not match the assignments\n");
+	if (filled != 150)
+		return fail(problem, "every slot of the roster can be filled\n");
+
+	printf("%d of 150 slots filled, preference cost %d\n", filled, summary.preferenceCost);
+	applewood_free(problem);
+
+	if (!rejectsRow(1, "Drama,1-50,10,two", "Invalid activity staff ratio") || !rejectsRow(0, "Bad,Archery,,,,ten", "Invalid staff workload limits"))
+		return 1;
+	if (!checkLocks(NULL, NULL) || !checkLocks("1,1,C,Archery,Staff4", "at the same time as another lock of Staff4")
+		|| !checkLocks("1,4,B,Crafts,Staff4", "locked into 3 slots on day 1") || !checkLocks("1,3,C,Archery,Staff4", "locked into 3 periods in a row on day 1"))
+		return 1;
+	return 0;
+}
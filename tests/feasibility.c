@@ -0,0 +1,52 @@
+//checks that a roster which passes every count of activities per time but cannot be scheduled is stopped before solving
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+//three activities can be led at every time of the second half of the cycle, which has 75 slots, but Drama can only be there 25 times and the others 20
+static const char scheduling[] =
+	"Activity,Times available,Times per cycle\n"
+	"Archery,1-25,20\n"
+	"Canoeing,1-25,20\n"
+	"Crafts,1-25,20\n"
+	"Drama,1-50,50\n"
+	"Fishing,1-50,20\n"
+	"Hiking,1-50,20\n"
+	"Staff\n"
+	"Partcipants\n"
+	"Ada,A,1-50\n"
+	"Ben,B,1-50\n"
+	"Cal,C,1-50\n";
+
+int main(void)
+{
+	ApplewoodProblem* problem;
+	ApplewoodSolveOptions options;
+	char row[96];
+	int index;
+
+	problem = applewood_create(scheduling, sizeof scheduling - 1, NULL, 0);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+
+	//enough staff who can lead everything, so only the activities are short
+	for (index = 0; index < 18; ++index)
+	{
+		sprintf(row, "Staff%d,Archery:Canoeing:Crafts:Drama:Fishing:Hiking,,,", index);
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+
+	memset(&options, 0, sizeof options);
+	options.seed = 1;
+	options.hasSeed = 1;
+	if (applewood_solve(problem, &options) == APPLEWOOD_OK)
+		return fail(problem, "a roster short of activities in the second half of the cycle was solved\n");
+	if (strstr(applewood_last_error(problem), "Activities can fill at most 140 of the 150 slots") == NULL)
+		return fail(problem, "the shortage was not found by Hall's condition\n");
+
+	printf("%s", applewood_last_error(problem));
+	applewood_free(problem);
+	return 0;
+}
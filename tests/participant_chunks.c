@@ -0,0 +1,87 @@
+//reads a participants section large enough to be counted in chunks on several threads and checks every slot's count against counting it row by row
+#include "test_util.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUMBER_OF_PARTICIPANTS 15000 //about 270 KB of rows, several times the smallest chunk the reader splits off for a thread
+#define NUMBER_OF_LEVELS 3
+#define NUMBER_OF_TIMES 50
+
+static const char roster[] =
+	"Activity,Times available,Times per cycle\n"
+	"Archery,1-50,50\n"
+	"Canoeing,1-50,50\n"
+	"Crafts,1-50,50\n"
+	"Staff\n"
+	"Partcipants\n";
+
+//gets the times a participant attends, one range early in the cycle and one late in it so rows differ in length
+static void getRanges(const int participant, int ranges[4])
+{
+	ranges[0] = 1 + participant % 20;
+	ranges[1] = ranges[0] + participant / 3 % (26 - ranges[0]);
+	ranges[2] = 26 + participant / 7 % 20;
+	ranges[3] = ranges[2] + participant / 11 % (51 - ranges[2]);
+}
+
+int main(void)
+{
+	static int expected[NUMBER_OF_LEVELS][NUMBER_OF_TIMES]; //the participants of each level at each time, counted here one row at a time
+	ApplewoodProblem* problem;
+	ApplewoodAssignment assignment;
+	char* scheduling;
+	size_t length, index;
+	char row[64];
+	int participant, time;
+
+	scheduling = malloc(sizeof roster + (size_t)NUMBER_OF_PARTICIPANTS * 32);
+	if (scheduling == NULL)
+		return fail(NULL, "malloc");
+	memcpy(scheduling, roster, sizeof roster);
+	length = sizeof roster - 1;
+	for (participant = 0; participant < NUMBER_OF_PARTICIPANTS; ++participant)
+	{
+		int ranges[4];
+		int level = participant % NUMBER_OF_LEVELS;
+		getRanges(participant, ranges);
+		length += (size_t)sprintf(scheduling + length, "P%d,%c,%d-%d:%d-%d\n", participant, 'A' + level, ranges[0], ranges[1], ranges[2], ranges[3]);
+		for (time = 0; time < NUMBER_OF_TIMES; ++time)
+		{
+			if ((time + 1 >= ranges[0] && time + 1 <= ranges[1]) || (time + 1 >= ranges[2] && time + 1 <= ranges[3]))
+				++expected[level][time];
+		}
+	}
+
+	problem = applewood_create(scheduling, length, NULL, 0);
+	free(scheduling);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+	for (index = 0; index < 15; ++index)
+	{
+		sprintf(row, "Staff%d,Archery,Canoeing:Crafts,,", (int)index);
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+	if (applewood_solve(problem, NULL) != APPLEWOOD_OK)
+		return fail(problem, "applewood_solve");
+
+	if (applewood_assignment_count(problem) != NUMBER_OF_LEVELS * NUMBER_OF_TIMES)
+		return fail(problem, "a slot is missing\n");
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return fail(problem, "applewood_get_assignment");
+		time = (assignment.day - 1) * 10 + assignment.period - 1;
+		if (assignment.participants != expected[assignment.level - 'A'][time])
+		{
+			fprintf(stderr, "day %d period %d level %c has %d participants rather than %d\n", assignment.day, assignment.period, assignment.level, assignment.participants, expected[assignment.level - 'A'][time]);
+			return fail(problem, "participant counts");
+		}
+	}
+
+	printf("%d participants counted the same in chunks as row by row\n", NUMBER_OF_PARTICIPANTS);
+	applewood_free(problem);
+	return 0;
+}
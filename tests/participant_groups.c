@@ -0,0 +1,182 @@
+//solves a roster whose slots have different numbers of participants, so it is filled one participant group at a time, and checks the schedule
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NUMBER_OF_ACTIVITIES 6
+#define NUMBER_OF_STAFF 18
+#define NUMBER_OF_TIMES 50
+
+static const char* const activityNames[NUMBER_OF_ACTIVITIES] = { "Archery", "Canoeing", "Crafts", "Drama", "Fishing", "Hiking" };
+
+//participants of each level over different ranges of times, giving the slots between 1 and 3 participants
+static const char* const participants[] = {
+	"Ada,A,1-50", "Abe,A,1-30", "Amy,A,21-50",
+	"Ben,B,1-50", "Bea,B,11-40",
+	"Cal,C,1-50", "Cy,C,1-10:41-50", "Cora,C,26-50"
+};
+
+//gets the index of a name in a list, -1 if it is not in it
+static int findName(const char* name, const char* const* names, const int size)
+{
+	int index;
+	for (index = 0; index < size; ++index)
+	{
+		if (strcmp(name, names[index]) == 0)
+			return index;
+	}
+	return -1;
+}
+
+//counts the participants of a level at a time from the participant rows above
+static int countParticipants(const char level, const int time)
+{
+	size_t index;
+	int count = 0;
+	for (index = 0; index < sizeof participants / sizeof participants[0]; ++index)
+	{
+		const char* ranges = participants[index] + strcspn(participants[index], ",") + 3;
+		int start, end, read;
+		if (participants[index][strcspn(participants[index], ",") + 1] != level)
+			continue;
+		while (sscanf(ranges, "%d-%d%n", &start, &end, &read) == 2)
+		{
+			if (time + 1 >= start && time + 1 <= end)
+				++count;
+			ranges += read;
+			if (*ranges != ':')
+				break;
+			++ranges;
+		}
+	}
+	return count;
+}
+
+static int solveAndCheck(ApplewoodProblem* problem, const int matching)
+{
+	ApplewoodSolveOptions options;
+	ApplewoodAssignment assignment;
+	char staffNames[NUMBER_OF_STAFF][16];
+	const char* staffPointers[NUMBER_OF_STAFF];
+	int activityTimes[NUMBER_OF_ACTIVITIES] = { 0 };
+	int staffLoads[NUMBER_OF_STAFF] = { 0 };
+	int activityAt[NUMBER_OF_TIMES][NUMBER_OF_ACTIVITIES];
+	int staffAt[NUMBER_OF_TIMES][NUMBER_OF_STAFF];
+	size_t index;
+	int filled = 0;
+
+	for (index = 0; index < NUMBER_OF_STAFF; ++index)
+	{
+		sprintf(staffNames[index], "Staff%d", (int)index);
+		staffPointers[index] = staffNames[index];
+	}
+	memset(activityAt, 0, sizeof activityAt);
+	memset(staffAt, 0, sizeof staffAt);
+
+	memset(&options, 0, sizeof options);
+	options.seed = 7;
+	options.hasSeed = 1;
+	options.matching = matching;
+	if (applewood_solve(problem, &options) != APPLEWOOD_OK)
+		return 0;
+
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		int time, activity, staff;
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return 0;
+		time = (assignment.day - 1) * 10 + assignment.period - 1;
+		if (assignment.participants != countParticipants(assignment.level, time))
+		{
+			fprintf(stderr, "day %d period %d level %c has %d participants\n", assignment.day, assignment.period, assignment.level, assignment.participants);
+			return 0;
+		}
+		if (assignment.activity == NULL)
+			continue;
+
+		activity = findName(assignment.activity, activityNames, NUMBER_OF_ACTIVITIES);
+		staff = findName(assignment.staff, staffPointers, NUMBER_OF_STAFF);
+		if (activity < 0 || staff < 0)
+		{
+			fprintf(stderr, "unknown activity %s or staff %s\n", assignment.activity, assignment.staff);
+			return 0;
+		}
+		if (staff % 3 == 0 && time < 3)
+		{
+			fprintf(stderr, "%s leads on their break on day %d period %d\n", assignment.staff, assignment.day, assignment.period);
+			return 0;
+		}
+		if (activityAt[time][activity]++ != 0 || staffAt[time][staff]++ != 0)
+		{
+			fprintf(stderr, "%s or %s is in two slots on day %d period %d\n", assignment.activity, assignment.staff, assignment.day, assignment.period);
+			return 0;
+		}
+		++activityTimes[activity];
+		++staffLoads[staff];
+		++filled;
+	}
+
+	for (index = 0; index < NUMBER_OF_ACTIVITIES; ++index)
+	{
+		if (activityTimes[index] > 25)
+		{
+			fprintf(stderr, "%s occurs %d times\n", activityNames[index], activityTimes[index]);
+			return 0;
+		}
+	}
+	for (index = 0; index < NUMBER_OF_STAFF; ++index)
+	{
+		if (staffLoads[index] > 10)
+		{
+			fprintf(stderr, "%s leads %d slots\n", staffNames[index], staffLoads[index]);
+			return 0;
+		}
+	}
+	if (filled != 150)
+	{
+		fprintf(stderr, "%d of 150 slots filled\n", filled);
+		return 0;
+	}
+	return 1;
+}
+
+int main(void)
+{
+	ApplewoodProblem* problem;
+	char row[96];
+	size_t index;
+
+	problem = applewood_create(NULL, 0, NULL, 0);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+
+	//six activities open all cycle, which together can fill every slot
+	for (index = 0; index < NUMBER_OF_ACTIVITIES; ++index)
+	{
+		sprintf(row, "%s,1-50,25", activityNames[index]);
+		if (applewood_add_activity(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_activity");
+	}
+	//each staff member leads at most 10 slots by default, a third of them have a break on the first day
+	for (index = 0; index < NUMBER_OF_STAFF; ++index)
+	{
+		sprintf(row, "Staff%d,%s,%s:%s,%s,%s", (int)index, activityNames[index % 6], activityNames[(index + 1) % 6], activityNames[(index + 2) % 6], activityNames[(index + 3) % 6], index % 3 == 0 ? "1-3" : "");
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+	for (index = 0; index < sizeof participants / sizeof participants[0]; ++index)
+	{
+		if (applewood_add_participant(problem, participants[index]) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_participant");
+	}
+
+	if (!solveAndCheck(problem, 0))
+		return fail(problem, "participant groups");
+	if (!solveAndCheck(problem, 1))
+		return fail(problem, "participant groups with matching");
+
+	printf("every slot filled by participant group, with and without matching\n");
+	applewood_free(problem);
+	return 0;
+}
@@ -0,0 +1,172 @@
+//solves a roster with an iteration limit, a time limit and large neighbourhood search, and checks the summary of each solve against its schedule
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NUMBER_OF_ACTIVITIES 6
+#define NUMBER_OF_STAFF 18
+#define NUMBER_OF_TIMES 50
+
+static const char* const activityNames[NUMBER_OF_ACTIVITIES] = { "Archery", "Canoeing", "Crafts", "Drama", "Fishing", "Hiking" };
+
+static const char* const participants[] = { "Ada,A,1-50", "Ben,B,1-50", "Cal,C,1-50" };
+
+//gets the index of a name in a list, -1 if it is not in it
+static int findName(const char* name, const char* const* names, const int size)
+{
+	int index;
+	for (index = 0; index < size; ++index)
+	{
+		if (strcmp(name, names[index]) == 0)
+			return index;
+	}
+	return -1;
+}
+
+//solves with the given options and checks that no activity or staff member is in two slots at once
+//and that the summary counts the same unfilled slots and preference cost as the schedule
+static int solveAndCheck(ApplewoodProblem* problem, const ApplewoodSolveOptions* options, ApplewoodSummary* summary)
+{
+	ApplewoodAssignment assignment;
+	char staffNames[NUMBER_OF_STAFF][16];
+	const char* staffPointers[NUMBER_OF_STAFF];
+	int activityAt[NUMBER_OF_TIMES][NUMBER_OF_ACTIVITIES];
+	int staffAt[NUMBER_OF_TIMES][NUMBER_OF_STAFF];
+	size_t index;
+	int unfilled = 0;
+	int preferenceCost = 0;
+
+	for (index = 0; index < NUMBER_OF_STAFF; ++index)
+	{
+		sprintf(staffNames[index], "Staff%d", (int)index);
+		staffPointers[index] = staffNames[index];
+	}
+	memset(activityAt, 0, sizeof activityAt);
+	memset(staffAt, 0, sizeof staffAt);
+
+	if (applewood_solve(problem, options) != APPLEWOOD_OK || applewood_get_summary(problem, summary) != APPLEWOOD_OK)
+		return 0;
+
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		int time, activity, staff, preference;
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return 0;
+		if (assignment.activity == NULL)
+		{
+			++unfilled;
+			continue;
+		}
+
+		time = (assignment.day - 1) * 10 + assignment.period - 1;
+		activity = findName(assignment.activity, activityNames, NUMBER_OF_ACTIVITIES);
+		staff = findName(assignment.staff, staffPointers, NUMBER_OF_STAFF);
+		if (activity < 0 || staff < 0)
+		{
+			fprintf(stderr, "unknown activity %s or staff %s\n", assignment.activity, assignment.staff);
+			return 0;
+		}
+		if (activityAt[time][activity]++ != 0 || staffAt[time][staff]++ != 0)
+		{
+			fprintf(stderr, "%s or %s is in two slots on day %d period %d\n", assignment.activity, assignment.staff, assignment.day, assignment.period);
+			return 0;
+		}
+
+		//staff prefer their own activity, are neutral about the next two and prefer not to lead the other three, as added in main
+		preference = (activity - staff % NUMBER_OF_ACTIVITIES + NUMBER_OF_ACTIVITIES) % NUMBER_OF_ACTIVITIES;
+		preferenceCost += preference == 0 ? 0 : preference <= 2 ? 1 : 2;
+	}
+
+	if (summary->unfilledSlots != unfilled || summary->preferenceCost != preferenceCost)
+	{
+		fprintf(stderr, "summary has %d unfilled slots and a preference cost of %d, the schedule has %d and %d\n", summary->unfilledSlots, summary->preferenceCost, unfilled, preferenceCost);
+		return 0;
+	}
+	return 1;
+}
+
+int main(void)
+{
+	ApplewoodProblem* problem;
+	ApplewoodSolveOptions options;
+	ApplewoodSummary unlimited, limited, timed, searched;
+	char row[96];
+	size_t index;
+
+	problem = applewood_create(NULL, 0, NULL, 0);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+
+	for (index = 0; index < NUMBER_OF_ACTIVITIES; ++index)
+	{
+		sprintf(row, "%s,1-50,25", activityNames[index]);
+		if (applewood_add_activity(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_activity");
+	}
+	//every staff member can lead every activity, so the search has a preference cost to bring down
+	for (index = 0; index < NUMBER_OF_STAFF; ++index)
+	{
+		sprintf(row, "Staff%d,%s,%s:%s,%s:%s:%s,", (int)index, activityNames[index % 6], activityNames[(index + 1) % 6], activityNames[(index + 2) % 6],
+			activityNames[(index + 3) % 6], activityNames[(index + 4) % 6], activityNames[(index + 5) % 6]);
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+	for (index = 0; index < sizeof participants / sizeof participants[0]; ++index)
+	{
+		if (applewood_add_participant(problem, participants[index]) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_participant");
+	}
+
+	memset(&options, 0, sizeof options);
+	options.seed = 11;
+	options.hasSeed = 1;
+	if (!solveAndCheck(problem, &options, &unlimited))
+		return fail(problem, "solve without limits");
+	if (unlimited.budgetExhausted != 0 || unlimited.unfilledSlots != 0)
+	{
+		fprintf(stderr, "a solve without limits left %d slots unfilled, budget exhausted %d\n", unlimited.unfilledSlots, unlimited.budgetExhausted);
+		return fail(problem, "solve without limits");
+	}
+
+	//a few iterations are not enough to fill 150 slots, so the solve stops early with a partial schedule
+	options.iterationLimit = 20;
+	if (!solveAndCheck(problem, &options, &limited))
+		return fail(problem, "solve with an iteration limit");
+	if (limited.budgetExhausted == 0 || limited.unfilledSlots == 0)
+	{
+		fprintf(stderr, "a solve limited to 20 iterations left %d slots unfilled, budget exhausted %d\n", limited.unfilledSlots, limited.budgetExhausted);
+		return fail(problem, "solve with an iteration limit");
+	}
+	if (limited.fingerprint == unlimited.fingerprint)
+		return fail(problem, "the iteration limit is not in the run fingerprint");
+
+	//a time limit which has passed before the first read of the clock stops the solve there
+	options.iterationLimit = 0;
+	options.timeLimit = 1e-9;
+	if (!solveAndCheck(problem, &options, &timed))
+		return fail(problem, "solve with a time limit");
+	if (timed.budgetExhausted == 0 || timed.unfilledSlots == 0)
+	{
+		fprintf(stderr, "a solve limited to a nanosecond left %d slots unfilled, budget exhausted %d\n", timed.unfilledSlots, timed.budgetExhausted);
+		return fail(problem, "solve with a time limit");
+	}
+
+	//large neighbourhood search only keeps repairs which score at least as well, and the greedy fill leaves staff on activities they prefer not to lead here
+	options.timeLimit = 0.0;
+	options.neighbourhoodIterations = 200;
+	if (!solveAndCheck(problem, &options, &searched))
+		return fail(problem, "solve with large neighbourhood search");
+	if (searched.budgetExhausted != 0 || searched.unfilledSlots > unlimited.unfilledSlots
+		|| (searched.unfilledSlots == unlimited.unfilledSlots && searched.preferenceCost >= unlimited.preferenceCost))
+	{
+		fprintf(stderr, "large neighbourhood search left %d slots unfilled at a preference cost of %d, from %d at %d\n", searched.unfilledSlots, searched.preferenceCost, unlimited.unfilledSlots, unlimited.preferenceCost);
+		return fail(problem, "solve with large neighbourhood search");
+	}
+	if (searched.fingerprint == unlimited.fingerprint)
+		return fail(problem, "the neighbourhood iterations are not in the run fingerprint");
+
+	printf("preference cost %d without limits, %d after large neighbourhood search, %d slots unfilled at the iteration limit\n", unlimited.preferenceCost, searched.preferenceCost, limited.unfilledSlots);
+	applewood_free(problem);
+	return 0;
+}
@@ -0,0 +1,110 @@
+//solves a roster whose activities need more than one staff member for larger groups and checks the size of every team
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NUMBER_OF_STAFF 36
+#define NUMBER_OF_TIMES 50
+#define MAXIMUM_TEAM 4
+
+//Archery needs a staff member for every 3 campers, Canoeing needs 2 staff however few campers it has and Crafts has no ratio
+//level A has 7 participants, level B 3 and level C 1, so the teams range from 1 to 3 staff
+static const char scheduling[] =
+	"Activity,Times available,Times per cycle,Campers per staff,Min staff\n"
+	"Archery,1-50,50,3,\n"
+	"Canoeing,1-50,50,,2\n"
+	"Crafts,1-50,50\n"
+	"Staff\n"
+	"Partcipants\n"
+	"A1,A,1-50\n" "A2,A,1-50\n" "A3,A,1-50\n" "A4,A,1-50\n" "A5,A,1-50\n" "A6,A,1-50\n" "A7,A,1-50\n"
+	"B1,B,1-50\n" "B2,B,1-50\n" "B3,B,1-50\n"
+	"C1,C,1-50\n";
+
+//gets the number of staff an activity needs, the lead included, for a given number of participants
+static int getStaffNeeded(const char* activity, const int participants)
+{
+	if (strcmp(activity, "Archery") == 0)
+		return (participants + 2) / 3;
+	if (strcmp(activity, "Canoeing") == 0)
+		return 2;
+	return 1;
+}
+
+int main(void)
+{
+	ApplewoodProblem* problem;
+	ApplewoodSolveOptions options;
+	ApplewoodAssignment assignment;
+	int staffAt[NUMBER_OF_TIMES][NUMBER_OF_STAFF];
+	char row[64];
+	size_t index;
+	int filled = 0;
+	int assisted = 0;
+
+	problem = applewood_create(scheduling, sizeof scheduling - 1, NULL, 0);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+	for (index = 0; index < NUMBER_OF_STAFF; ++index)
+	{
+		sprintf(row, "Staff%d,Archery:Canoeing:Crafts,,,", (int)index);
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+
+	memset(&options, 0, sizeof options);
+	options.seed = 3;
+	options.hasSeed = 1;
+	if (applewood_solve(problem, &options) != APPLEWOOD_OK)
+		return fail(problem, "applewood_solve");
+
+	memset(staffAt, 0, sizeof staffAt);
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		const char* team[MAXIMUM_TEAM];
+		const char* assistant;
+		int size, member, time, staff;
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return fail(problem, "applewood_get_assignment");
+		if (assignment.activity == NULL)
+		{
+			if (applewood_get_assistant(problem, index, 0) != NULL)
+				return fail(problem, "an unfilled slot has assistants\n");
+			continue;
+		}
+
+		//the lead and every assistant form the team, which must be exactly the size the ratio asks for
+		team[0] = assignment.staff;
+		size = 1;
+		while ((assistant = applewood_get_assistant(problem, index, (size_t)size - 1)) != NULL)
+		{
+			if (size == MAXIMUM_TEAM)
+				return fail(problem, "a team is larger than any ratio asks for\n");
+			team[size++] = assistant;
+		}
+		if (size != getStaffNeeded(assignment.activity, assignment.participants))
+		{
+			fprintf(stderr, "%s with %d participants on day %d period %d has a team of %d\n", assignment.activity, assignment.participants, assignment.day, assignment.period, size);
+			return fail(problem, "team size");
+		}
+
+		//no staff member is on two teams at once
+		time = (assignment.day - 1) * 10 + assignment.period - 1;
+		for (member = 0; member < size; ++member)
+		{
+			if (sscanf(team[member], "Staff%d", &staff) != 1 || staff < 0 || staff >= NUMBER_OF_STAFF || staffAt[time][staff]++ != 0)
+			{
+				fprintf(stderr, "%s is unknown or on two teams on day %d period %d\n", team[member], assignment.day, assignment.period);
+				return fail(problem, "team members");
+			}
+		}
+		assisted += size > 1;
+		++filled;
+	}
+	if (filled == 0 || assisted == 0)
+		return fail(problem, "no slot was filled with a team\n");
+
+	printf("%d slots filled, %d of them by a team of more than one staff member\n", filled, assisted);
+	applewood_free(problem);
+	return 0;
+}
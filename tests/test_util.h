@@ -0,0 +1,17 @@
+//helpers shared by the tests of the C interface
+#ifndef APPLEWOOD_TEST_UTIL_H
+#define APPLEWOOD_TEST_UTIL_H
+
+#include "ApplewoodScheduling.h"
+
+#include <stdio.h>
+
+//prints what failed and the problem's last error, frees the problem and returns the exit code of a failed test
+static inline int fail(ApplewoodProblem* problem, const char* what)
+{
+	fprintf(stderr, "%s: %s", what, problem == NULL ? "no problem\n" : applewood_last_error(problem));
+	applewood_free(problem);
+	return 1;
+}
+
+#endif
@@ -0,0 +1,142 @@
+//solves a roster whose staff have workload limits through the C interface and checks that no staff member leads beyond them
+#include "test_util.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#define NUMBER_OF_STAFF 20
+#define NUMBER_OF_DAYS 5
+#define PERIODS_IN_DAY 10
+
+//three activities are only open on day 1 and three on the other days, so the staff who lead them are needed on those days only
+static const char scheduling[] =
+	"Activity,Times available,Times per cycle\n"
+	"Archery,1-10,10\n"
+	"Canoeing,1-10,10\n"
+	"Crafts,1-10,10\n"
+	"Drama,11-50,40\n"
+	"Fishing,11-50,40\n"
+	"Hiking,11-50,40\n"
+	"Staff\n"
+	"Partcipants\n"
+	"Ada,A,1-50\n"
+	"Ben,B,1-50\n"
+	"Cal,C,1-50\n";
+
+//the workload limit columns of each staff member: minimum load, maximum load, daily cap and max consecutive periods
+typedef struct Limits
+{
+	int minimumLoad;
+	int maximumLoad;
+	int dailyCap;
+	int maxConsecutive;
+} Limits;
+
+//gets the limits of a staff member, the day 1 staff differ only in their daily cap so they would be interchangeable without it
+static Limits getLimits(const int staff)
+{
+	Limits limits = { 0, 10, 10, 10 };
+	if (staff < 6)
+		limits.dailyCap = staff % 2 == 0 ? 2 : 10;
+	else
+	{
+		limits.minimumLoad = 1;
+		limits.dailyCap = 6;
+		limits.maxConsecutive = 3;
+	}
+	return limits;
+}
+
+static int solveAndCheck(ApplewoodProblem* problem, const int matching)
+{
+	ApplewoodSolveOptions options;
+	ApplewoodAssignment assignment;
+	int busy[NUMBER_OF_STAFF][NUMBER_OF_DAYS][PERIODS_IN_DAY];
+	int loads[NUMBER_OF_STAFF] = { 0 };
+	size_t index;
+	int staff, day, period;
+
+	memset(busy, 0, sizeof busy);
+	memset(&options, 0, sizeof options);
+	options.seed = 5;
+	options.hasSeed = 1;
+	options.matching = matching;
+	if (applewood_solve(problem, &options) != APPLEWOOD_OK)
+		return 0;
+
+	for (index = 0; index < applewood_assignment_count(problem); ++index)
+	{
+		if (applewood_get_assignment(problem, index, &assignment) != APPLEWOOD_OK)
+			return 0;
+		if (assignment.staff == NULL)
+			continue;
+		if (sscanf(assignment.staff, "Staff%d", &staff) != 1 || staff < 0 || staff >= NUMBER_OF_STAFF)
+		{
+			fprintf(stderr, "unknown staff %s\n", assignment.staff);
+			return 0;
+		}
+		busy[staff][assignment.day - 1][assignment.period - 1] = 1;
+		++loads[staff];
+	}
+
+	for (staff = 0; staff < NUMBER_OF_STAFF; ++staff)
+	{
+		Limits limits = getLimits(staff);
+		if (loads[staff] < limits.minimumLoad || loads[staff] > limits.maximumLoad)
+		{
+			fprintf(stderr, "Staff%d leads %d slots, outside %d to %d\n", staff, loads[staff], limits.minimumLoad, limits.maximumLoad);
+			return 0;
+		}
+		for (day = 0; day < NUMBER_OF_DAYS; ++day)
+		{
+			int onDay = 0;
+			int run = 0;
+			for (period = 0; period < PERIODS_IN_DAY; ++period)
+			{
+				run = busy[staff][day][period] ? run + 1 : 0;
+				onDay += busy[staff][day][period];
+				if (run > limits.maxConsecutive)
+				{
+					fprintf(stderr, "Staff%d leads %d periods in a row on day %d\n", staff, run, day + 1);
+					return 0;
+				}
+			}
+			if (onDay > limits.dailyCap)
+			{
+				fprintf(stderr, "Staff%d leads %d slots on day %d against a cap of %d\n", staff, onDay, day + 1, limits.dailyCap);
+				return 0;
+			}
+		}
+	}
+	return 1;
+}
+
+int main(void)
+{
+	ApplewoodProblem* problem;
+	char row[96];
+	int staff;
+
+	problem = applewood_create(scheduling, sizeof scheduling - 1, NULL, 0);
+	if (problem == NULL)
+		return fail(NULL, "applewood_create");
+
+	//the first six staff lead the day 1 activities and are on break for the rest of the cycle, the others are on break on day 1
+	for (staff = 0; staff < NUMBER_OF_STAFF; ++staff)
+	{
+		Limits limits = getLimits(staff);
+		sprintf(row, "Staff%d,%s,,,%s,%d,%d,%d,%d", staff, staff < 6 ? "Archery:Canoeing:Crafts" : "Drama:Fishing:Hiking", staff < 6 ? "11-50" : "1-10",
+			limits.minimumLoad, limits.maximumLoad, limits.dailyCap, limits.maxConsecutive);
+		if (applewood_add_staff(problem, row) != APPLEWOOD_OK)
+			return fail(problem, "applewood_add_staff");
+	}
+
+	if (!solveAndCheck(problem, 0))
+		return fail(problem, "workload limits");
+	if (!solveAndCheck(problem, 1))
+		return fail(problem, "workload limits with matching");
+
+	printf("every staff member leads within their workload limits, with and without matching\n");
+	applewood_free(problem);
+	return 0;
+}